@@ -2,9 +2,20 @@
 // Created by winderica on 11/18/2018.
 //
 
+#define _POSIX_C_SOURCE 200809L // clock_gettime and pthreads under -std=c11
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <malloc.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
 
 /* type definitions */
 // status type
@@ -25,379 +36,4699 @@ typedef int ElemType;
 
 typedef struct LinkNode {
     ElemType value;
+    Boolean dead; // tombstone of lazy deletion, fits in the padding before `next`
     struct LinkNode *next;
 } LinkNode;
 
+// block of nodes carved out by an arena
+typedef struct NodeBlock {
+    struct NodeBlock *next;
+    int used;
+    int capacity;
+    LinkNode nodes[];
+} NodeBlock;
+
+// node allocator of lists, whose nodes are all released at once when no list shares it
+typedef struct {
+    NodeBlock *blocks; // most recent block first
+    LinkNode *free; // nodes given back one by one, linked by `next`
+    int refCount; // lists using it
+} NodeArena;
+
+// number of nodes of the first and the largest arena block
+#define ARENA_MIN_BLOCK 64
+#define ARENA_MAX_BLOCK 65536
+
+// entry of the hash index of a list
+typedef struct IndexEntry {
+    LinkNode *node;
+    LinkNode *prev; // predecessor of `node`, NULL if `node` is head
+    struct IndexEntry *next; // next entry in the same value bucket
+    struct IndexEntry **link; // pointer to this entry in its value bucket, to unlink it in O(1)
+    struct IndexEntry *nodeNext; // next entry in the same node bucket
+} IndexEntry;
+
+// chained hash index from value to node and from node to its entry, `1 << bits` buckets each
+typedef struct {
+    IndexEntry **buckets;
+    IndexEntry **nodeBuckets; // keyed by node address, so duplicates of a value don't slow down lookups
+    int bits;
+    int size;
+} LinkIndex;
+
+// log2 of initial bucket number of an index
+#define INDEX_MIN_BITS 4
+
+// counting Bloom filter, counters saturate and then stay set
+typedef struct {
+    uint8_t *counters;
+    uint32_t size; // number of counters
+    int hashes; // counters touched per value
+    int capacity; // number of values it was sized for
+    double rate; // false positive rate it was sized for
+} LinkFilter;
+
+// value of a saturated filter counter
+#define FILTER_SATURATED UINT8_MAX
+
+// ln 2, for sizing filters, M_LN2 of <math.h> isn't ISO C
+#define LN2 0.69314718055994530942
+
 typedef struct {
     LinkNode *head;
-    int length;
+    LinkNode *tail;
+    int length; // number of live nodes
+    int dead; // number of tombstones still linked
+    int capacity; // max length, 0 if unbounded
+    LinkIndex *index; // optional, NULL if not indexed, also holds predecessors for an O(1) `popBack`
+    LinkFilter *filter; // optional, NULL if not filtered
+    NodeArena *arena; // optional, NULL if nodes are allocated one by one
+    LinkNode **jumpTable; // prefetch hints, node addresses in list order, built lazily
+    int jumpLength;
+    int organize; // self-organizing mode of `locateElem`, one of ORGANIZE_*
+    long long lookups; // lookups counted since the mode was set
+    long long probes; // nodes compared by those lookups
     Boolean initialized;
 } LinkList;
 
-/**
- * Initialize an list
- * @param {LinkList *} list - pointer to a list
- * @return {Status} - execution status
+// tombstones are purged once they make up more than this ratio of linked nodes
+#define TOMBSTONE_RATIO 0.5
+
+// self-organizing modes, a successful lookup leaves the node where it is,
+// moves it to the front, or swaps it with its predecessor
+#define ORGANIZE_NONE 0
+#define ORGANIZE_MOVE_TO_FRONT 1
+#define ORGANIZE_TRANSPOSE 2
+
+// number of nodes to prefetch ahead during traversal
+#define PREFETCH_DISTANCE 16
+// lists shorter than this are traversed without prefetching
+#define PREFETCH_MIN_LENGTH 4096
+
+/*
+ * Persistent list: nodes are immutable and reference counted, so versions
+ * share common suffixes. A node is referenced by each version whose head it
+ * is and by each node whose `next` it is. Not thread-safe.
  */
-Status initializeList(LinkList *list) {
+typedef struct PersistentNode {
+    ElemType value;
+    int refCount;
+    struct PersistentNode *next;
+} PersistentNode;
 
-    if (list->initialized) { // already exists
-        return ERROR;
-    }
+// a version of a persistent list
+typedef struct {
+    PersistentNode *head;
+    int length;
+    Boolean initialized;
+} PersistentList;
 
-    // initialize
-    list->head = NULL;
-    list->length = 0;
-    list->initialized = TRUE;
-    return OK;
-}
+// capacity of the bounded queue of `queueBenchmark`
+#define QUEUE_BENCHMARK_CAPACITY 1024
+
+// sum of values visited by `sumHelper`
+long long traverseSum;
+
+// size of buffer of file streams
+#define STREAM_BUFFER_SIZE (1 << 20)
+// magic number of binary list file ("LLST")
+#define LIST_MAGIC 0x54534C4Cu
+
+// buffered file stream
+typedef struct {
+    FILE *fp;
+    char *buffer;
+    size_t length; // bytes in buffer
+    size_t position; // next byte to read
+    Boolean failed;
+} StreamBuffer;
+
+// header of binary list file, followed by `length` packed values
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int64_t length;
+    uint64_t checksum; // FNV-style hash of values
+} ListFileHeader;
+
+// max number of threads of `listSort`
+#define SORT_MAX_THREADS 64
+// lists shorter than this are always sorted on the calling thread
+#define SORT_PARALLEL_THRESHOLD 65536
+
+// segment sorted, or pair of segments merged, by a thread of `listSort`
+typedef struct {
+    LinkNode *head;
+    LinkNode *other;
+} SortSegment;
+
+// null link of compact list
+#define COMPACT_NULL UINT32_MAX
+// magic number of compact list file ("CLST")
+#define COMPACT_MAGIC 0x54534C43u
+
+/*
+ * Compact list: values and 32-bit `next` indices live in parallel arrays,
+ * free slots are chained through `next`. 8 bytes per element instead of a
+ * malloc'ed 16-byte `LinkNode`, and the arrays can be saved/loaded as is.
+ */
+typedef struct {
+    ElemType *values;
+    uint32_t *next;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t freeHead;
+    uint32_t capacity;
+    int length;
+    Boolean initialized;
+} CompactList;
+
+// max number of threads of an epoch domain
+#define EPOCH_MAX_THREADS 128
+// try to advance the epoch after this many retired nodes
+#define EPOCH_ADVANCE_INTERVAL 64
+
+// nodes retired in one epoch by one thread
+typedef struct {
+    void **items;
+    int count;
+    int capacity;
+} LimboBag;
+
+// per-thread state, aligned to a cache line to avoid false sharing
+typedef struct {
+    _Alignas(64) _Atomic unsigned long epoch;
+    _Atomic Boolean active;
+    unsigned long lastEpoch;
+    int retiredCount;
+    LimboBag limbo[3];
+} EpochRecord;
+
+/*
+ * Epoch-based reclamation: a node unlinked in epoch `e` is released once
+ * its retiring thread observes epoch `e + 3`; the global epoch only moves
+ * forward when every thread inside a critical section has seen it.
+ */
+typedef struct {
+    _Atomic unsigned long epoch;
+    _Atomic int threads;
+    void (*reclaim)(void *, void *, int);
+    void *context;
+    EpochRecord records[EPOCH_MAX_THREADS];
+} EpochDomain;
+
+// the low bit of `next` marks the node as logically deleted
+#define CONCURRENT_MARKED(link) ((link) & (uintptr_t) 1)
+#define CONCURRENT_UNMARK(link) ((link) & ~(uintptr_t) 1)
+#define CONCURRENT_POINTER(link) ((ConcurrentNode *) CONCURRENT_UNMARK(link))
+
+typedef struct ConcurrentNode {
+    ElemType value;
+    _Atomic(uintptr_t) next;
+} ConcurrentNode;
+
+// lock-free sorted set (Harris/Michael)
+typedef struct {
+    ConcurrentNode head; // sentinel, its value is never read
+    EpochDomain domain;
+    Boolean initialized;
+} ConcurrentSet;
+
+// argument of benchmark threads
+typedef struct {
+    ConcurrentSet *set;
+    int operations;
+    int range;
+    uint64_t seed;
+    int delta;
+} ConcurrentWorker;
+
+// max number of nodes kept in the pool of one thread
+#define QUEUE_POOL_MAX 4096
+// max batch size of `queueConcurrencyBenchmark`
+#define QUEUE_BATCH_MAX 256
+
+// node of concurrent queue, a `LinkNode` with an atomic link
+typedef struct QueueNode {
+    ElemType value;
+    _Atomic(struct QueueNode *) next;
+} QueueNode;
+
+// recycled nodes of one thread, only touched by that thread
+typedef struct {
+    _Alignas(64) QueueNode *free;
+    int count;
+} QueuePool;
+
+// lock-free multi-producer/multi-consumer FIFO (Michael-Scott), `head` is a dummy node
+typedef struct {
+    _Alignas(64) _Atomic(QueueNode *) head;
+    _Alignas(64) _Atomic(QueueNode *) tail;
+    EpochDomain domain;
+    QueuePool pools[EPOCH_MAX_THREADS];
+    Boolean initialized;
+} ConcurrentQueue;
+
+// argument of queue benchmark threads
+typedef struct {
+    ConcurrentQueue *queue; // NULL to use `list` under `mutex`
+    LinkList *list;
+    pthread_mutex_t *mutex;
+    int operations;
+    int batch;
+    ElemType base;
+    long long produced;
+    long long consumed;
+} QueueWorker;
 
 /**
- * Traverse the list and print items
- * @param {LinkList *} list - pointer to list
- * @param {void (*)(ElemType)} visitor - print function
- * @return {Status} - execution status
+ * Helper function to get the bucket of a value in an index
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {ElemType} e - value
+ * @return {IndexEntry **} - pointer to the head of bucket
  */
-Status listTraverse(LinkList *list, void (*visitor)(LinkNode *)) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
-    }
-    LinkNode *node = list->head;
-    while (node) {
-        LinkNode *next = node->next; // save the pointer to next node in case `visitor` function free this node
-        visitor(node);
-        node = next;
-    }
-    return OK;
+IndexEntry **indexBucket(LinkIndex *index, ElemType e) {
+    // Fibonacci hashing: capacity is a power of two
+    uint32_t hash = (uint32_t) e * 2654435769u;
+    return &index->buckets[hash >> (32 - index->bits)];
 }
 
 /**
- * Helper function to free node
+ * Helper function to get the bucket of a node in an index
+ * @param {LinkIndex *} index - pointer to an index
  * @param {LinkNode *} node - node
- * @return {void}
+ * @return {IndexEntry **} - pointer to the head of bucket
  */
-void freeHelper(LinkNode *node) {
-    free(node);
+IndexEntry **indexNodeBucket(LinkIndex *index, LinkNode *node) {
+    uint64_t hash = (uint64_t) (uintptr_t) node * 0x9E3779B97F4A7C15ull;
+    return &index->nodeBuckets[hash >> (64 - index->bits)];
 }
 
 /**
- * Destroy an list
- * @param {LinkList *} list - pointer to a list
- * @return {Status} - execution status
+ * Helper function to link an entry into both of its buckets
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {IndexEntry *} entry - entry
+ * @return {void}
  */
-Status destroyList(LinkList *list) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void indexLinkHelper(LinkIndex *index, IndexEntry *entry) {
+    IndexEntry **bucket = indexBucket(index, entry->node->value);
+    entry->next = *bucket;
+    if (*bucket) {
+        (*bucket)->link = &entry->next;
     }
-    listTraverse(list, freeHelper); // use `listTraverse` function to free nodes of the list
-
-    // destroy head node
-    free(list->head);
-    list->length = 0;
-    list->initialized = FALSE;
-    return OK;
+    entry->link = bucket;
+    *bucket = entry;
+    bucket = indexNodeBucket(index, entry->node);
+    entry->nodeNext = *bucket;
+    *bucket = entry;
 }
 
 /**
- * Empty an list
- * @param {LinkList *} list - pointer to a list
- * @return {Status} - execution status
+ * Helper function to create an empty index
+ * @param {int} bits - log2 of bucket number
+ * @return {LinkIndex *} - the index, NULL on overflow
  */
-Status clearList(LinkList *list) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+LinkIndex *indexCreate(int bits) {
+    LinkIndex *index = (LinkIndex *) malloc(sizeof(LinkIndex));
+    if (!index) {
+        return NULL;
     }
-    listTraverse(list, freeHelper); // use `listTraverse` function to free nodes of the list
-
-    // reinitialize head node
-    list->head = NULL;
-    list->length = 0;
-    return OK;
+    index->bits = bits;
+    index->size = 0;
+    index->buckets = (IndexEntry **) calloc((size_t) 1 << bits, sizeof(IndexEntry *));
+    index->nodeBuckets = (IndexEntry **) calloc((size_t) 1 << bits, sizeof(IndexEntry *));
+    if (!index->buckets || !index->nodeBuckets) {
+        free(index->buckets);
+        free(index->nodeBuckets);
+        free(index);
+        return NULL;
+    }
+    return index;
 }
 
 /**
- * Is a list empty
- * @param {LinkList *} list - pointer to list
- * @return {Boolean}
+ * Helper function to free all entries of an index
+ * @param {LinkIndex *} index - pointer to an index
+ * @return {void}
  */
-Boolean isListEmpty(LinkList *list) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void indexClear(LinkIndex *index) {
+    int capacity = 1 << index->bits;
+    for (int i = 0; i < capacity; i++) {
+        IndexEntry *entry = index->buckets[i];
+        while (entry) {
+            IndexEntry *next = entry->next;
+            free(entry);
+            entry = next;
+        }
+        index->buckets[i] = NULL;
+        index->nodeBuckets[i] = NULL;
     }
-
-    return list->head == NULL ? TRUE : FALSE;
+    index->size = 0;
 }
 
 /**
- * Get list length
- * @param {LinkList *} list - pointer to list
- * @return {int}
+ * Helper function to free an index
+ * @param {LinkIndex *} index - pointer to an index, may be NULL
+ * @return {void}
  */
-int listLength(LinkList *list) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void indexFree(LinkIndex *index) {
+    if (index) {
+        indexClear(index);
+        free(index->buckets);
+        free(index->nodeBuckets);
+        free(index);
     }
-    return list->length;
 }
 
 /**
- * Get element's value on specified index
- * @param {LinkList *} list - pointer to list
- * @param {int} i - index
- * @param {ElemType *} e - pointer to element
- * @return {Status} - execution status
+ * Helper function to find the entry of a node
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - node
+ * @return {IndexEntry *} - entry, NULL if not indexed
  */
-Status getElem(LinkList *list, int i, ElemType *e) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+IndexEntry *indexFindNode(LinkIndex *index, LinkNode *node) {
+    IndexEntry *entry = *indexNodeBucket(index, node);
+    while (entry && entry->node != node) {
+        entry = entry->nodeNext;
     }
+    return entry;
+}
 
-    if (i < 1 || i > list->length) { // index is illegal
-        return ERROR;
+/**
+ * Helper function to find the only entry of a value
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {ElemType} e - value
+ * @param {int *} count - number of nodes holding `e`, counting stops at 2
+ * @return {IndexEntry *} - an entry of `e`, NULL if `e` isn't in the list
+ */
+IndexEntry *indexFindValue(LinkIndex *index, ElemType e, int *count) {
+    IndexEntry *found = NULL;
+    *count = 0;
+    for (IndexEntry *entry = *indexBucket(index, e); entry && *count < 2; entry = entry->next) {
+        if (entry->node->value == e) {
+            found = entry;
+            (*count)++;
+        }
     }
+    return found;
+}
 
-    LinkNode *node = list->head;
-    // loop until index `i`
-    for (int j = 1; j < i; j++) {
-        node = node->next;
+/**
+ * Helper function to index a node, doubling buckets when the load factor exceeds 1
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - node
+ * @param {LinkNode *} prev - predecessor of node, NULL if node is head
+ * @return {Status} - execution status
+ */
+Status indexAdd(LinkIndex *index, LinkNode *node, LinkNode *prev) {
+    if (index->size >= 1 << index->bits && index->bits < 30) {
+        IndexEntry **buckets = (IndexEntry **) calloc((size_t) 2 << index->bits, sizeof(IndexEntry *));
+        IndexEntry **nodeBuckets = (IndexEntry **) calloc((size_t) 2 << index->bits, sizeof(IndexEntry *));
+        if (buckets && nodeBuckets) { // rehash, otherwise keep the longer chains
+            IndexEntry **old = index->buckets;
+            int capacity = 1 << index->bits;
+            free(index->nodeBuckets);
+            index->buckets = buckets;
+            index->nodeBuckets = nodeBuckets;
+            index->bits++;
+            for (int i = 0; i < capacity; i++) {
+                IndexEntry *entry = old[i];
+                while (entry) {
+                    IndexEntry *next = entry->next;
+                    indexLinkHelper(index, entry);
+                    entry = next;
+                }
+            }
+            free(old);
+        } else {
+            free(buckets);
+            free(nodeBuckets);
+        }
     }
-    *e = node->value;
+    IndexEntry *entry = (IndexEntry *) malloc(sizeof(IndexEntry));
+    if (!entry) {
+        return OVERFLOW;
+    }
+    entry->node = node;
+    entry->prev = prev;
+    indexLinkHelper(index, entry);
+    index->size++;
     return OK;
 }
 
 /**
- * Get element's index by function `compare`
- * @param {LinkList *} list - pointer to list
- * @param {int} e - value to be compared
- * @param {Status (*)(ElemType, ElemType)} compare - function of comparing
- * @return {int} - index of the element
+ * Helper function to remove the entry of a node
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - node
+ * @return {void}
  */
-int locateElem(LinkList *list, ElemType e, Status (*compare)(ElemType, ElemType)) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void indexRemove(LinkIndex *index, LinkNode *node) {
+    IndexEntry **link = indexNodeBucket(index, node);
+    while (*link && (*link)->node != node) {
+        link = &(*link)->nodeNext;
     }
-
-    int i = 1;
-    LinkNode *node = list->head;
-    // find until the element is located or come to the end of list
-    while (node && compare(e, node->value) == FALSE) {
-        i++;
-        node = node->next;
+    if (*link) {
+        IndexEntry *entry = *link;
+        *link = entry->nodeNext;
+        *entry->link = entry->next;
+        if (entry->next) {
+            entry->next->link = entry->link;
+        }
+        free(entry);
+        index->size--;
     }
-
-    return i > listLength(list) ? 0 : i;
 }
 
 /**
- * Comparing function
- * @param {ElemType} x
- * @param {ElemType} y
- * @return {Boolean}
+ * Helper function to update the predecessor of a node
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - node, may be NULL
+ * @param {LinkNode *} prev - new predecessor
+ * @return {void}
  */
-Boolean equal(ElemType x, ElemType y) {
-    return x == y;
+void indexSetPrev(LinkIndex *index, LinkNode *node, LinkNode *prev) {
+    if (node) {
+        IndexEntry *entry = indexFindNode(index, node);
+        if (entry) {
+            entry->prev = prev;
+        }
+    }
 }
 
 /**
- * Get element's previous element
- * @param {LinkList *} list - pointer to list
- * @param {ElemType} curr - current element
- * @param {ElemType *} prev - pointer to previous element
+ * Helper function to index a chain of nodes
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - first node of the chain
+ * @param {LinkNode *} prev - predecessor of the first node
+ * @param {LinkNode *} end - node after the last node of the chain
  * @return {Status} - execution status
  */
-Status priorElem(LinkList *list, ElemType curr, ElemType *prev) {
-
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
-    }
-
-    int i = 1;
-    LinkNode *node = list->head;
-    // find until the element is located or come to the end of list
-    while (node && node->next && node->next->value != curr) {
-        i++;
+Status indexAddChain(LinkIndex *index, LinkNode *node, LinkNode *prev, LinkNode *end) {
+    while (node != end) {
+        if (indexAdd(index, node, prev) != OK) {
+            return OVERFLOW;
+        }
+        prev = node;
         node = node->next;
     }
+    return OK;
+}
 
-    if (i >= listLength(list)) {
-        return ERROR;
+/**
+ * Helper function to remove a NULL-terminated chain of nodes from an index
+ * @param {LinkIndex *} index - pointer to an index
+ * @param {LinkNode *} node - first node of the chain
+ * @return {void}
+ */
+void indexRemoveChain(LinkIndex *index, LinkNode *node) {
+    while (node) {
+        indexRemove(index, node);
+        node = node->next;
     }
+}
 
-    *prev = node->value;
-    return OK;
+/**
+ * Helper function to drop the index of a list that ran out of memory while indexing, since
+ * an index missing some nodes would answer lookups wrongly
+ * @param {LinkList *} list - pointer to list
+ * @return {void}
+ */
+void indexDropHelper(LinkList *list) {
+    indexFree(list->index);
+    list->index = NULL;
 }
 
 /**
- * Get element's next element
+ * Helper function to reindex a list whose nodes were all relinked, the index is dropped on overflow
  * @param {LinkList *} list - pointer to list
- * @param {ElemType} curr - current element
- * @param {ElemType *} next - pointer to next element
- * @return {Status} - execution status
+ * @return {void}
  */
-Status nextElem(LinkList *list, ElemType curr, ElemType *next) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void indexRebuildHelper(LinkList *list) {
+    if (list->index) {
+        indexClear(list->index);
+        if (indexAddChain(list->index, list->head, NULL, NULL) != OK) {
+            indexDropHelper(list);
+        }
     }
+}
 
-    int i = 1;
-    LinkNode *node = list->head;
-    // find until the element is located or come to the end of list
-    while (node && node->value != curr) {
-        i++;
-        node = node->next;
-    }
+/**
+ * Helper function to get the two base hashes of a value, the i-th counter is `h1 + i * h2`
+ * @param {ElemType} e - value
+ * @param {uint32_t *} h2 - set to the second hash, always odd
+ * @return {uint32_t} - the first hash
+ */
+uint32_t filterHash(ElemType e, uint32_t *h2) {
+    uint64_t x = (uint64_t) (uint32_t) e + 0x9E3779B97F4A7C15ull; // splitmix64 finalizer
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    *h2 = (uint32_t) (x >> 32) | 1;
+    return (uint32_t) x;
+}
 
-    if (i >= listLength(list)) {
-        return ERROR;
+/**
+ * Create a counting Bloom filter sized for `capacity` values at false positive rate `rate`
+ * @param {int} capacity - expected number of values
+ * @param {double} rate - false positive rate, in (0, 1)
+ * @return {LinkFilter *} - the filter, NULL if arguments are illegal or out of memory
+ */
+LinkFilter *filterCreate(int capacity, double rate) {
+    if (capacity < 1 || rate <= 0 || rate >= 1) {
+        return NULL;
     }
-
-    *next = node->next->value;
-    return OK;
+    // m = -n ln p / (ln 2)^2, k = m / n ln 2
+    double size = -capacity * log(rate) / (LN2 * LN2);
+    if (size > UINT32_MAX) {
+        return NULL;
+    }
+    LinkFilter *filter = (LinkFilter *) malloc(sizeof(LinkFilter));
+    if (!filter) {
+        return NULL;
+    }
+    filter->size = size < 64 ? 64 : (uint32_t) ceil(size);
+    filter->hashes = (int) round(size / capacity * LN2); // before rounding the size up
+    if (filter->hashes < 1) {
+        filter->hashes = 1;
+    }
+    filter->capacity = capacity;
+    filter->rate = rate;
+    filter->counters = (uint8_t *) calloc(filter->size, sizeof(uint8_t));
+    if (!filter->counters) {
+        free(filter);
+        return NULL;
+    }
+    return filter;
 }
 
 /**
- * Insert an element to a list
- * @param {LinkList *} list - pointer to list
- * @param {int} i - index of element to be inserted
- * @param {ElemType} e - the element to be inserted
- * @return {Status} - execution status
+ * Free a filter
+ * @param {LinkFilter *} filter - filter, may be NULL
+ * @return {void}
  */
-Status listInsert(LinkList *list, int i, ElemType e) {
-    if (!list->initialized) { // list doesn't exist
-        return ERROR;
+void filterFree(LinkFilter *filter) {
+    if (filter) {
+        free(filter->counters);
+        free(filter);
     }
+}
 
-    if (i < 1 || i > list->length + 1) { // index is illegal
+/**
+ * Add a value to a filter
+ * @param {LinkFilter *} filter - filter
+ * @param {ElemType} e - value
+ * @return {void}
+ */
+void filterAdd(LinkFilter *filter, ElemType e) {
+    uint32_t h2, h = filterHash(e, &h2);
+    for (int i = 0; i < filter->hashes; i++, h += h2) {
+        uint8_t *counter = &filter->counters[h % filter->size];
+        if (*counter != FILTER_SATURATED) {
+            (*counter)++;
+        }
+    }
+}
+
+/**
+ * Remove a value which was added to a filter
+ * @param {LinkFilter *} filter - filter
+ * @param {ElemType} e - value
+ * @return {void}
+ */
+void filterRemove(LinkFilter *filter, ElemType e) {
+    uint32_t h2, h = filterHash(e, &h2);
+    for (int i = 0; i < filter->hashes; i++, h += h2) {
+        uint8_t *counter = &filter->counters[h % filter->size];
+        if (*counter != FILTER_SATURATED) { // a saturated counter no longer knows its count
+            (*counter)--;
+        }
+    }
+}
+
+/**
+ * Judge whether a value may be in a filter
+ * @param {LinkFilter *} filter - filter
+ * @param {ElemType} e - value
+ * @return {Boolean} - FALSE if the value is definitely absent
+ */
+Boolean filterContains(LinkFilter *filter, ElemType e) {
+    uint32_t h2, h = filterHash(e, &h2);
+    for (int i = 0; i < filter->hashes; i++, h += h2) {
+        if (!filter->counters[h % filter->size]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * Helper function to add or remove values of the live nodes of a chain in the filter of a list
+ * @param {LinkList *} list - pointer to list
+ * @param {LinkNode *} node - first node of the chain
+ * @param {LinkNode *} end - node after the chain, NULL if the chain runs to the end
+ * @param {Boolean} add - TRUE to add, FALSE to remove
+ * @return {void}
+ */
+void filterChainHelper(LinkList *list, LinkNode *node, LinkNode *end, Boolean add) {
+    if (!list->filter) {
+        return;
+    }
+    for (; node != end; node = node->next) {
+        if (node->dead) { // its value left the filter when it was marked
+            continue;
+        }
+        if (add) {
+            filterAdd(list->filter, node->value);
+        } else {
+            filterRemove(list->filter, node->value);
+        }
+    }
+}
+
+/**
+ * Create an arena used by one list
+ * @return {NodeArena *} - the arena, NULL if out of memory
+ */
+NodeArena *arenaCreate() {
+    NodeArena *arena = (NodeArena *) malloc(sizeof(NodeArena));
+    if (arena) {
+        arena->blocks = NULL;
+        arena->free = NULL;
+        arena->refCount = 1;
+    }
+    return arena;
+}
+
+/**
+ * Release all nodes of an arena at once, keeping only its current block for reuse
+ * @param {NodeArena *} arena - arena
+ * @return {void}
+ */
+void arenaReset(NodeArena *arena) {
+    NodeBlock *block = arena->blocks;
+    if (block) {
+        NodeBlock *next = block->next;
+        while (next) {
+            NodeBlock *following = next->next;
+            free(next);
+            next = following;
+        }
+        block->next = NULL;
+        block->used = 0;
+    }
+    arena->free = NULL;
+}
+
+/**
+ * Drop a reference to an arena, freeing it with all its nodes when no list uses it any more
+ * @param {NodeArena *} arena - arena, may be NULL
+ * @return {void}
+ */
+void arenaRelease(NodeArena *arena) {
+    if (arena && --arena->refCount == 0) {
+        arenaReset(arena);
+        free(arena->blocks);
+        free(arena);
+    }
+}
+
+/**
+ * Allocate a node for a list, from its arena if it has one
+ * @param {LinkList *} list - pointer to list
+ * @return {LinkNode *} - the node, NULL if out of memory
+ */
+LinkNode *allocateNode(LinkList *list) {
+    NodeArena *arena = list->arena;
+    if (!arena) {
+        return (LinkNode *) malloc(sizeof(LinkNode));
+    }
+    if (arena->free) {
+        LinkNode *node = arena->free;
+        arena->free = node->next;
+        return node;
+    }
+    NodeBlock *block = arena->blocks;
+    if (!block || block->used == block->capacity) { // grow geometrically
+        int capacity = block ? block->capacity * 2 : ARENA_MIN_BLOCK;
+        if (capacity > ARENA_MAX_BLOCK) {
+            capacity = ARENA_MAX_BLOCK;
+        }
+        block = (NodeBlock *) malloc(sizeof(NodeBlock) + capacity * sizeof(LinkNode));
+        if (!block) {
+            return NULL;
+        }
+        block->next = arena->blocks;
+        block->used = 0;
+        block->capacity = capacity;
+        arena->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
+
+/**
+ * Allocate `n` contiguous nodes from an arena in a block of their own
+ * @param {NodeArena *} arena - arena
+ * @param {int} n - number of nodes
+ * @return {LinkNode *} - the first node, NULL if out of memory
+ */
+LinkNode *arenaAllocateBlock(NodeArena *arena, int n) {
+    NodeBlock *block = (NodeBlock *) malloc(sizeof(NodeBlock) + (size_t) n * sizeof(LinkNode));
+    if (!block) {
+        return NULL;
+    }
+    block->used = n;
+    block->capacity = n;
+    if (arena->blocks) { // behind the current block, which may still have room
+        block->next = arena->blocks->next;
+        arena->blocks->next = block;
+    } else {
+        block->next = NULL;
+        arena->blocks = block;
+    }
+    return block->nodes;
+}
+
+/**
+ * Give a node back to where `allocateNode` took it from
+ * @param {LinkList *} list - pointer to list
+ * @param {LinkNode *} node - node
+ * @return {void}
+ */
+void releaseNode(LinkList *list, LinkNode *node) {
+    if (list->arena) {
+        node->next = list->arena->free;
+        list->arena->free = node;
+    } else {
+        free(node);
+    }
+}
+
+/**
+ * Initialize an list
+ * @param {LinkList *} list - pointer to a list
+ * @return {Status} - execution status
+ */
+Status initializeList(LinkList *list) {
+
+    if (list->initialized) { // already exists
         return ERROR;
     }
 
-    LinkNode *newNode = (LinkNode *) malloc(sizeof(LinkNode));
-    newNode->value = e;
-    if (i == 1) { // insert to index 1
-        newNode->next = list->head;
-        list->head = newNode;
-    } else { // insert to other index
-        LinkNode *node = list->head;
-        for (int j = 1; j < i - 1; j++) { // go to previous node
-            node = node->next;
+    // initialize
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->dead = 0;
+    list->capacity = 0;
+    list->index = NULL;
+    list->filter = NULL;
+    list->arena = NULL;
+    list->jumpTable = NULL;
+    list->jumpLength = 0;
+    list->organize = ORGANIZE_NONE;
+    list->lookups = 0;
+    list->probes = 0;
+    list->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Traverse the list and print items
+ * @param {LinkList *} list - pointer to list
+ * @param {void (*)(ElemType)} visitor - print function
+ * @return {Status} - execution status
+ */
+Status listTraverse(LinkList *list, void (*visitor)(LinkNode *)) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    LinkNode *node = list->head;
+    while (node) {
+        LinkNode *next = node->next; // save the pointer to next node in case `visitor` function free this node
+        if (!node->dead) {
+            visitor(node);
         }
-        // change pointer to next
-        newNode->next = node->next;
-        node->next = newNode;
+        node = next;
     }
-    list->length++;
     return OK;
 }
 
 /**
- * Delete the specified element from a list
+ * Unlink and free all tombstones of a list in one pass
  * @param {LinkList *} list - pointer to list
- * @param {int} i - index of element to be deleted
- * @param {ElemType *} e - the element to be deleted
  * @return {Status} - execution status
  */
-Status listDelete(LinkList *list, int i, ElemType *e) {
+Status listPurge(LinkList *list) {
     if (!list->initialized) { // list doesn't exist
         return ERROR;
     }
+    if (!list->dead) { // nothing to purge
+        return OK;
+    }
+    LinkNode *last = NULL; // last live node
+    LinkNode **link = &list->head;
+    Boolean moved = FALSE; // whether the predecessor of the next live node changed
+    while (*link) {
+        LinkNode *node = *link;
+        if (node->dead) {
+            *link = node->next;
+            if (list->index) {
+                indexRemove(list->index, node);
+            }
+            releaseNode(list, node);
+            moved = TRUE;
+            continue;
+        }
+        if (moved && list->index) {
+            indexSetPrev(list->index, node, last);
+        }
+        moved = FALSE;
+        last = node;
+        link = &node->next;
+    }
+    list->tail = last;
+    list->dead = 0;
+    return OK;
+}
+
+/**
+ * Delete a node lazily: mark it as a tombstone, which traversal, lookup and positional access skip
+ * and which is freed by `listPurge`, explicitly or once tombstones exceed TOMBSTONE_RATIO.
+ * O(1) expected on indexed lists, whose index tells whether the node belongs to the list,
+ * otherwise the list is scanned up to the node to check that
+ * @param {LinkList *} list - pointer to list
+ * @param {LinkNode *} node - a live node of the list from `listFind`, invalidated by anything that
+ *                            frees or relinks nodes, such as purging, compaction, sorting or deletion
+ * @return {Status} - execution status, ERROR if the node isn't a live node of the list
+ */
+Status listMarkDead(LinkList *list, LinkNode *node) {
+    if (!list->initialized || !node || node->dead) { // list doesn't exist or node is already dead
+        return ERROR;
+    }
+    if (list->index) {
+        if (!indexFindNode(list->index, node)) { // node of another list
+            return ERROR;
+        }
+    } else {
+        LinkNode *curr = list->head;
+        while (curr && curr != node) {
+            curr = curr->next;
+        }
+        if (!curr) { // node of another list
+            return ERROR;
+        }
+    }
+    node->dead = TRUE;
+    list->dead++;
+    list->length--;
+    if (list->filter) {
+        filterRemove(list->filter, node->value);
+    }
+    if (list->dead > TOMBSTONE_RATIO * (list->length + list->dead)) {
+        listPurge(list);
+    }
+    return OK;
+}
 
-    if (i < 1 || i > list->length) { // index is illegal
+/**
+ * Helper function to free the tombstones at the front of a list, so that repeated deletes
+ * from the front don't walk over them again
+ * @param {LinkList *} list - pointer to list
+ * @return {void}
+ */
+void trimFrontHelper(LinkList *list) {
+    while (list->head && list->head->dead) {
+        LinkNode *node = list->head;
+        list->head = node->next;
+        if (list->tail == node) {
+            list->tail = NULL;
+        }
+        if (list->index) {
+            indexRemove(list->index, node);
+            indexSetPrev(list->index, list->head, NULL);
+        }
+        releaseNode(list, node);
+        list->dead--;
+    }
+}
+
+/**
+ * Helper function to walk to the i-th live node, skipping tombstones
+ * @param {LinkList *} list - pointer to list
+ * @param {int} i - index of a live node, from 1 to the length of list
+ * @param {LinkNode **} prev - set to the predecessor of the node, which may be a tombstone, if not NULL
+ * @return {LinkNode *} - the node
+ */
+LinkNode *liveNodeHelper(LinkList *list, int i, LinkNode **prev) {
+    LinkNode *before = NULL, *node = list->head;
+    while (node->dead || --i) {
+        before = node;
+        node = node->next;
+    }
+    if (prev) {
+        *prev = before;
+    }
+    return node;
+}
+
+/**
+ * Helper function to free node
+ * @param {LinkNode *} node - node
+ * @return {void}
+ */
+void freeHelper(LinkNode *node) {
+    free(node);
+}
+
+/**
+ * Empty an list
+ * @param {LinkList *} list - pointer to a list
+ * @return {Status} - execution status
+ */
+Status clearList(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
         return ERROR;
     }
-    LinkNode *nodeToBeDeleted;
-    if (i == 1) { // delete index 1
-        nodeToBeDeleted = list->head;
-        list->head = nodeToBeDeleted->next;
-    } else { // delete other index
+    if (list->arena && list->arena->refCount == 1) { // every node lives in the arena, release them at once
+        arenaReset(list->arena);
+    } else if (list->arena) { // other lists share the arena, give nodes back one by one
         LinkNode *node = list->head;
-        for (int j = 1; j < i - 1; j++) { // go to previous node
-            node = node->next;
+        while (node) {
+            LinkNode *next = node->next;
+            releaseNode(list, node);
+            node = next;
         }
-        // change pointer to next
-        nodeToBeDeleted = node->next;
-        node->next = nodeToBeDeleted->next;
+    } else {
+        listPurge(list);
+        listTraverse(list, freeHelper); // use `listTraverse` function to free nodes of the list
     }
-    *e = nodeToBeDeleted->value;
-    free(nodeToBeDeleted);
-    list->length--;
+
+    // reinitialize head node
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    list->dead = 0;
+    if (list->index) {
+        indexClear(list->index);
+    }
+    if (list->filter) {
+        memset(list->filter->counters, 0, list->filter->size);
+    }
+    free(list->jumpTable);
+    list->jumpTable = NULL;
+    list->jumpLength = 0;
     return OK;
 }
 
 /**
- * Select a list
- * @param {LinkList **} currentList - pointer to `LinkList *currentList`
- * @param {LinkList *} nextList - pointer to nextList
+ * Destroy an list
+ * @param {LinkList *} list - pointer to a list
  * @return {Status} - execution status
  */
-Status selectList(LinkList **currentList, LinkList *nextList) {
-    *currentList = nextList;
+Status destroyList(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    clearList(list);
+
+    indexFree(list->index);
+    list->index = NULL;
+    filterFree(list->filter);
+    list->filter = NULL;
+    arenaRelease(list->arena);
+    list->arena = NULL;
+    list->initialized = FALSE;
     return OK;
 }
 
 /**
- * Load data from a file
- * @param {LinkList *} list - list
+ * Is a list empty
+ * @param {LinkList *} list - pointer to list
+ * @return {Boolean}
+ */
+Boolean isListEmpty(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    return list->length == 0 ? TRUE : FALSE; // tombstones may still be linked
+}
+
+/**
+ * Get list length
+ * @param {LinkList *} list - pointer to list
+ * @return {int}
+ */
+int listLength(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    return list->length;
+}
+
+/**
+ * Get element's value on specified index
+ * @param {LinkList *} list - pointer to list
+ * @param {int} i - index
+ * @param {ElemType *} e - pointer to element
  * @return {Status} - execution status
  */
-Status loadData(LinkList *list) {
-    FILE *fp = fopen("data.txt", "r");
-    if (fp == NULL) { // file doesn't exist
-        printf("File doesn't exist!\n");
+Status getElem(LinkList *list, int i, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
         return ERROR;
     }
-    Status result = initializeList(list);
-    if (result == ERROR) {
-        printf("This list has ALREADY been initialized!\n");
-        fclose(fp);
+
+    if (i < 1 || i > list->length) { // index is illegal
         return ERROR;
-    } else if (result == OVERFLOW) {
-        printf("Overflow!\n");
-        fclose(fp);
+    }
+
+    LinkNode *node = list->head;
+    while (node->dead) {
+        node = node->next;
+    }
+    // loop until index `i`
+    for (int j = 1; j < i; j++) {
+        do { // tombstones don't count
+            node = node->next;
+        } while (node->dead);
+    }
+    *e = node->value;
+    return OK;
+}
+
+/**
+ * Build a hash index from value to node and predecessor, which all mutators then keep up to date
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listBuildIndex(LinkList *list) {
+    if (!list->initialized || list->index) { // list doesn't exist or is already indexed
+        return ERROR;
+    }
+    listPurge(list);
+    int bits = INDEX_MIN_BITS;
+    while (bits < 30 && 1 << bits < list->length) {
+        bits++;
+    }
+    list->index = indexCreate(bits);
+    if (!list->index) {
+        return OVERFLOW;
+    }
+    if (indexAddChain(list->index, list->head, NULL, NULL) != OK) {
+        indexDropHelper(list);
+        return OVERFLOW;
+    }
+    return OK;
+}
+
+/**
+ * Drop the hash index of a list
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listDropIndex(LinkList *list) {
+    if (!list->initialized || !list->index) { // list doesn't exist or isn't indexed
+        return ERROR;
+    }
+    indexFree(list->index);
+    list->index = NULL;
+    return OK;
+}
+
+/**
+ * Attach a counting Bloom filter to a list, so that lookups of most absent values touch no node
+ * @param {LinkList *} list - pointer to list
+ * @param {int} capacity - expected number of values, 0 for the current length
+ * @param {double} rate - false positive rate at `capacity` values, in (0, 1)
+ * @return {Status} - execution status
+ */
+Status listBuildFilter(LinkList *list, int capacity, double rate) {
+    if (!list->initialized || capacity < 0) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    if (!capacity) {
+        capacity = list->length ? list->length : 1;
+    }
+    LinkFilter *filter = filterCreate(capacity, rate);
+    if (!filter) {
+        return rate > 0 && rate < 1 ? OVERFLOW : ERROR;
+    }
+    filterFree(list->filter); // rebuilding resizes
+    list->filter = filter;
+    filterChainHelper(list, list->head, NULL, TRUE);
+    return OK;
+}
+
+/**
+ * Drop the filter of a list
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listDropFilter(LinkList *list) {
+    if (!list->initialized || !list->filter) { // list doesn't exist or isn't filtered
+        return ERROR;
+    }
+    filterFree(list->filter);
+    list->filter = NULL;
+    return OK;
+}
+
+/**
+ * Estimate the current false positive rate of the filter of a list, (1 - e^(-kn/m))^k
+ * @param {LinkList *} list - pointer to list
+ * @return {double} - the rate, 1 if the list isn't filtered
+ */
+double listFilterRate(LinkList *list) {
+    if (!list->initialized || !list->filter) {
+        return 1;
+    }
+    LinkFilter *filter = list->filter;
+    return pow(1 - exp(-(double) filter->hashes * list->length / filter->size), filter->hashes);
+}
+
+/**
+ * Find the first node holding a value, O(1) expected on indexed lists. The node stays valid
+ * until nodes of the list are freed or relinked, e.g. by purging, compaction, sorting or deletion
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} e - value
+ * @param {LinkNode **} prev - set to the predecessor of the node, which may be a tombstone, if not NULL
+ * @return {LinkNode *} - the node, NULL if not found
+ */
+LinkNode *listFind(LinkList *list, ElemType e, LinkNode **prev) {
+    if (!list->initialized) { // list doesn't exist
+        return NULL;
+    }
+    if (list->filter && !filterContains(list->filter, e)) { // definitely absent
+        if (prev) {
+            *prev = NULL;
+        }
+        return NULL;
+    }
+    if (list->index) {
+        int count;
+        IndexEntry *entry = indexFindValue(list->index, e, &count);
+        if (count < 2 && !(entry && entry->node->dead)) { // with duplicates, only a scan knows which one comes first
+            if (prev) {
+                *prev = entry ? entry->prev : NULL;
+            }
+            return entry ? entry->node : NULL;
+        }
+    }
+    LinkNode *before = NULL, *node = list->head;
+    while (node && (node->dead || node->value != e)) {
+        before = node;
+        node = node->next;
+    }
+    if (prev) {
+        *prev = before;
+    }
+    return node;
+}
+
+/**
+ * Delete the first node holding a value
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} e - value
+ * @return {Status} - execution status
+ */
+Status listDeleteValue(LinkList *list, ElemType e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    LinkNode *prev;
+    LinkNode *node = listFind(list, e, &prev);
+    if (!node) {
+        return ERROR;
+    }
+    if (prev) {
+        prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node == list->tail) {
+        list->tail = prev;
+    }
+    if (list->index) {
+        indexRemove(list->index, node);
+        indexSetPrev(list->index, node->next, prev);
+    }
+    if (list->filter) {
+        filterRemove(list->filter, node->value);
+    }
+    releaseNode(list, node);
+    list->length--;
+    return OK;
+}
+
+/**
+ * Helper function to check whether the jump table of a list still looks current.
+ * A stale table only makes prefetches useless, never traversal wrong, because
+ * prefetching an address never faults and nodes are always reached through `next`
+ * @param {LinkList *} list - pointer to list
+ * @return {Boolean}
+ */
+Boolean jumpValidHelper(LinkList *list) {
+    return list->jumpTable && list->jumpLength == list->length && list->length > 0
+           && list->jumpTable[0] == list->head && list->jumpTable[list->length - 1] == list->tail;
+}
+
+/**
+ * Build the jump table of a list: addresses of nodes in list order, used as prefetch hints
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listBuildJumpTable(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    if (jumpValidHelper(list)) {
+        return OK;
+    }
+    free(list->jumpTable);
+    list->jumpTable = (LinkNode **) malloc((list->length + 1) * sizeof(LinkNode *));
+    if (!list->jumpTable) {
+        list->jumpLength = 0;
+        return OVERFLOW;
+    }
+    int i = 0;
+    for (LinkNode *node = list->head; node; node = node->next) {
+        list->jumpTable[i++] = node;
+    }
+    list->jumpLength = i;
+    return OK;
+}
+
+/**
+ * Traverse the list with prefetching `PREFETCH_DISTANCE` nodes ahead, building the jump table lazily.
+ * Unlike `listTraverse`, `visitor` must not free nodes
+ * @param {LinkList *} list - pointer to list
+ * @param {void (*)(LinkNode *)} visitor - visit function
+ * @return {Status} - execution status
+ */
+Status listTraversePrefetch(LinkList *list, void (*visitor)(LinkNode *)) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    if (list->length < PREFETCH_MIN_LENGTH || listBuildJumpTable(list) != OK) { // not worth it
+        return listTraverse(list, visitor);
+    }
+    LinkNode **jumps = list->jumpTable;
+    int length = list->length;
+    int ahead = length < PREFETCH_DISTANCE ? length : PREFETCH_DISTANCE;
+    for (int i = 0; i < ahead; i++) { // warm up
+        __builtin_prefetch(jumps[i]);
+    }
+    int i = 0;
+    for (LinkNode *node = list->head; node; node = node->next, i++) {
+        if (i + PREFETCH_DISTANCE < length) {
+            __builtin_prefetch(jumps[i + PREFETCH_DISTANCE]);
+        }
+        if (!node->dead) {
+            visitor(node);
+        }
+    }
+    return OK;
+}
+
+/**
+ * Helper function to compare node addresses for `qsort`
+ * @param {const void *} x - pointer to a node pointer
+ * @param {const void *} y - pointer to a node pointer
+ * @return {int}
+ */
+int addressCompareHelper(const void *x, const void *y) {
+    uintptr_t a = (uintptr_t) *(LinkNode *const *) x;
+    uintptr_t b = (uintptr_t) *(LinkNode *const *) y;
+    return a < b ? -1 : a > b;
+}
+
+/**
+ * Relayout a list so that traversal visits nodes in ascending address order.
+ * Nodes stay where they are, values are moved between them and the chain is relinked,
+ * so no node is reallocated, but pointers to nodes, e.g. from `listFind`, no longer hold the same values
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listCompact(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    int length = list->length;
+    if (length < 2) {
+        return OK;
+    }
+    LinkNode **nodes = (LinkNode **) malloc(length * sizeof(LinkNode *));
+    ElemType *values = (ElemType *) malloc(length * sizeof(ElemType));
+    if (!nodes || !values) {
+        free(nodes);
+        free(values);
+        return OVERFLOW;
+    }
+    int i = 0;
+    for (LinkNode *node = list->head; node; node = node->next, i++) {
+        nodes[i] = node;
+        values[i] = node->value;
+    }
+    qsort(nodes, length, sizeof(LinkNode *), addressCompareHelper);
+    for (i = 0; i < length; i++) {
+        nodes[i]->value = values[i];
+        nodes[i]->next = i + 1 < length ? nodes[i + 1] : NULL;
+    }
+    list->head = nodes[0];
+    list->tail = nodes[length - 1];
+    free(values);
+    // the sorted array is exactly the new jump table
+    free(list->jumpTable);
+    list->jumpTable = nodes;
+    list->jumpLength = length;
+    indexRebuildHelper(list);
+    return OK;
+}
+
+/**
+ * Let an empty list allocate its nodes from an arena of its own,
+ * so that `clearList` and `destroyList` release them in one bulk operation
+ * @param {LinkList *} list - pointer to an empty list
+ * @return {Status} - execution status
+ */
+Status listUseArena(LinkList *list) {
+    if (!list->initialized || list->arena) { // list doesn't exist or already uses an arena
+        return ERROR;
+    }
+    listPurge(list);
+    if (list->head) { // nodes already allocated must be freed the way they were allocated
+        return ERROR;
+    }
+    list->arena = arenaCreate();
+    return list->arena ? OK : OVERFLOW;
+}
+
+/**
+ * Set the self-organizing mode of a list and reset its probe counters,
+ * only meaningful for unordered lists since it changes the order of nodes
+ * @param {LinkList *} list - pointer to list
+ * @param {int} mode - one of ORGANIZE_*
+ * @return {Status} - execution status
+ */
+Status listSetOrganize(LinkList *list, int mode) {
+    if (!list->initialized || mode < ORGANIZE_NONE || mode > ORGANIZE_TRANSPOSE) {
+        return ERROR;
+    }
+    list->organize = mode;
+    list->lookups = 0;
+    list->probes = 0;
+    return OK;
+}
+
+/**
+ * Get average number of nodes compared per `locateElem` since the mode was set
+ * @param {LinkList *} list - pointer to list
+ * @return {double} - average probe depth, 0 if nothing was looked up
+ */
+double listProbeDepth(LinkList *list) {
+    return list->initialized && list->lookups ? (double) list->probes / list->lookups : 0;
+}
+
+/**
+ * Helper function to move a found node forward according to the self-organizing mode
+ * @param {LinkList *} list - pointer to list
+ * @param {LinkNode *} node - the found node
+ * @param {LinkNode *} prev - its predecessor, NULL if it's the head
+ * @param {LinkNode *} before - the last live node before it, NULL if it's the first live node
+ * @param {LinkNode *} beforePrev - predecessor of `before`, NULL if `before` is the head
+ * @param {int} i - position of the node
+ * @return {int} - new position of the node
+ */
+int organizeHelper(LinkList *list, LinkNode *node, LinkNode *prev, LinkNode *before, LinkNode *beforePrev, int i) {
+    if (!before || list->organize == ORGANIZE_NONE) { // already in front or not organized
+        return i;
+    }
+    LinkNode *next = node->next;
+    if (list->organize == ORGANIZE_MOVE_TO_FRONT) {
+        LinkNode *head = list->head;
+        if (list->tail == node) {
+            list->tail = prev;
+        }
+        prev->next = next;
+        node->next = head;
+        list->head = node;
+        if (list->index) {
+            indexSetPrev(list->index, next, prev);
+            indexSetPrev(list->index, head, node);
+            indexSetPrev(list->index, node, NULL);
+        }
+        return 1;
+    }
+    // transpose: beforePrev -> before -> ... -> prev -> node -> next
+    // becomes beforePrev -> node -> ... -> prev -> before -> next, tombstones in between stay
+    LinkNode *after = before->next; // `node` itself unless tombstones are in between
+    if (beforePrev) {
+        beforePrev->next = node;
+    } else {
+        list->head = node;
+    }
+    if (after == node) {
+        node->next = before;
+    } else {
+        node->next = after;
+        prev->next = before;
+    }
+    before->next = next;
+    if (list->tail == node) {
+        list->tail = before;
+    }
+    if (list->index) {
+        indexSetPrev(list->index, node, beforePrev);
+        if (after != node) {
+            indexSetPrev(list->index, after, node);
+        }
+        indexSetPrev(list->index, before, after == node ? node : prev);
+        indexSetPrev(list->index, next, before);
+    }
+    return i - 1;
+}
+
+/**
+ * Comparing function
+ * @param {ElemType} x
+ * @param {ElemType} y
+ * @return {Boolean}
+ */
+Boolean equal(ElemType x, ElemType y) {
+    return x == y;
+}
+
+/**
+ * Get element's index by function `compare`
+ * @param {LinkList *} list - pointer to list
+ * @param {int} e - value to be compared
+ * @param {Status (*)(ElemType, ElemType)} compare - function of comparing
+ * @return {int} - index of the element
+ */
+int locateElem(LinkList *list, ElemType e, Status (*compare)(ElemType, ElemType)) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    list->lookups++;
+    if (list->filter && compare == equal && !filterContains(list->filter, e)) { // definitely absent
+        return 0;
+    }
+    if (list->index && compare == equal) {
+        LinkNode *prev;
+        LinkNode *found = listFind(list, e, &prev);
+        if (!found) { // a miss is answered without touching any node
+            return 0;
+        }
+        if (list->organize == ORGANIZE_MOVE_TO_FRONT) { // no need to count the position
+            list->probes++;
+            // moving the first live node behind leading tombstones to the front is harmless
+            return organizeHelper(list, found, prev, prev, NULL, 1);
+        }
+        int i = 1;
+        LinkNode *before = NULL, *beforePrev = NULL;
+        for (LinkNode *node = list->head, *last = NULL; node != found; last = node, node = node->next) { // count the position
+            if (!node->dead) {
+                i++;
+                before = node;
+                beforePrev = last;
+            }
+        }
+        list->probes += i;
+        return organizeHelper(list, found, prev, before, beforePrev, i);
+    }
+
+    int i = 1;
+    LinkNode *node = list->head, *prev = NULL, *before = NULL, *beforePrev = NULL;
+    // prefetch along the jump table if there is a current one
+    LinkNode **jumps = jumpValidHelper(list) ? list->jumpTable : NULL;
+    // find until the element is located or come to the end of list
+    while (node && (node->dead || compare(e, node->value) == FALSE)) {
+        if (jumps && i + PREFETCH_DISTANCE <= list->length) {
+            __builtin_prefetch(jumps[i + PREFETCH_DISTANCE - 1]);
+        }
+        if (!node->dead) {
+            i++;
+            before = node;
+            beforePrev = prev;
+        }
+        prev = node;
+        node = node->next;
+    }
+
+    if (!node) {
+        list->probes += list->length;
+        return 0;
+    }
+    list->probes += i;
+    return organizeHelper(list, node, prev, before, beforePrev, i);
+}
+
+/**
+ * Get element's previous element
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} curr - current element
+ * @param {ElemType *} prev - pointer to previous element
+ * @return {Status} - execution status
+ */
+Status priorElem(LinkList *list, ElemType curr, ElemType *prev) {
+
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (list->index) {
+        LinkNode *before;
+        if (!listFind(list, curr, &before)) {
+            return ERROR;
+        }
+        while (before && before->dead) { // step back over tombstones
+            before = indexFindNode(list->index, before)->prev;
+        }
+        if (!before) {
+            return ERROR;
+        }
+        *prev = before->value;
+        return OK;
+    }
+
+    LinkNode *before = NULL, *node = list->head;
+    // find until the element is located after a live node or come to the end of list
+    while (node && (node->dead || !before || node->value != curr)) {
+        if (!node->dead) {
+            before = node;
+        }
+        node = node->next;
+    }
+
+    if (!node) {
+        return ERROR;
+    }
+
+    *prev = before->value;
+    return OK;
+}
+
+/**
+ * Get element's next element
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} curr - current element
+ * @param {ElemType *} next - pointer to next element
+ * @return {Status} - execution status
+ */
+Status nextElem(LinkList *list, ElemType curr, ElemType *next) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    LinkNode *node;
+    if (list->index) {
+        node = listFind(list, curr, NULL);
+    } else {
+        node = list->head;
+        // find until the element is located or come to the end of list
+        while (node && (node->dead || node->value != curr)) {
+            node = node->next;
+        }
+    }
+    if (!node) {
+        return ERROR;
+    }
+    node = node->next;
+    while (node && node->dead) { // skip tombstones
+        node = node->next;
+    }
+
+    if (!node) {
+        return ERROR;
+    }
+
+    *next = node->value;
+    return OK;
+}
+
+/**
+ * Insert an element to a list
+ * @param {LinkList *} list - pointer to list
+ * @param {int} i - index of element to be inserted
+ * @param {ElemType} e - the element to be inserted
+ * @return {Status} - execution status
+ */
+Status listInsert(LinkList *list, int i, ElemType e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    if (list->capacity && list->length >= list->capacity) { // list is full
+        return OVERFLOW;
+    }
+
+    LinkNode *newNode = allocateNode(list);
+    if (!newNode) {
+        return OVERFLOW;
+    }
+    LinkNode *node = NULL;
+    newNode->value = e;
+    newNode->dead = FALSE;
+    if (i > 1 && i == list->length + 1) { // behind tombstones at the back too
+        node = list->tail;
+    } else if (i > 1) {
+        node = liveNodeHelper(list, i - 1, NULL); // go to previous live node
+    }
+    if (list->index && indexAdd(list->index, newNode, node) != OK) { // index before linking, so failure leaves the list as is
+        releaseNode(list, newNode);
+        return OVERFLOW;
+    }
+    if (i == 1) { // insert to index 1
+        newNode->next = list->head;
+        list->head = newNode;
+    } else { // insert after node, the tail when appending
+        // change pointer to next
+        newNode->next = node->next;
+        node->next = newNode;
+    }
+    if (newNode->next == NULL) {
+        list->tail = newNode;
+    }
+    if (list->index) {
+        indexSetPrev(list->index, newNode->next, newNode);
+    }
+    if (list->filter) {
+        filterAdd(list->filter, e);
+    }
+    list->length++;
+    return OK;
+}
+
+/**
+ * Delete the specified element from a list
+ * @param {LinkList *} list - pointer to list
+ * @param {int} i - index of element to be deleted
+ * @param {ElemType *} e - the element to be deleted
+ * @return {Status} - execution status
+ */
+Status listDelete(LinkList *list, int i, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length) { // index is illegal
+        return ERROR;
+    }
+    if (i == 1) {
+        trimFrontHelper(list);
+    }
+    LinkNode *node;
+    LinkNode *nodeToBeDeleted = liveNodeHelper(list, i, &node);
+    if (node) { // change pointer to next
+        node->next = nodeToBeDeleted->next;
+    } else {
+        list->head = nodeToBeDeleted->next;
+    }
+    if (nodeToBeDeleted == list->tail) {
+        list->tail = node;
+    }
+    if (list->index) {
+        indexRemove(list->index, nodeToBeDeleted);
+        indexSetPrev(list->index, nodeToBeDeleted->next, node);
+    }
+    if (list->filter) {
+        filterRemove(list->filter, nodeToBeDeleted->value);
+    }
+    *e = nodeToBeDeleted->value;
+    releaseNode(list, nodeToBeDeleted);
+    list->length--;
+    return OK;
+}
+
+/**
+ * Bound the length of a list, pushes and inserts into a full list fail with OVERFLOW
+ * @param {LinkList *} list - pointer to list
+ * @param {int} capacity - max length, 0 for unbounded
+ * @return {Status} - execution status
+ */
+Status listSetCapacity(LinkList *list, int capacity) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (capacity < 0 || (capacity && capacity < list->length)) { // capacity is illegal
+        return ERROR;
+    }
+    list->capacity = capacity;
+    return OK;
+}
+
+/**
+ * Is a bounded list full
+ * @param {LinkList *} list - pointer to list
+ * @return {Boolean}
+ */
+Boolean isListFull(LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    return list->capacity && list->length >= list->capacity ? TRUE : FALSE;
+}
+
+/**
+ * Insert an element before the first element in O(1)
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} e - the element to be inserted
+ * @return {Status} - execution status, OVERFLOW if the list is full
+ */
+Status pushFront(LinkList *list, ElemType e) {
+    return listInsert(list, 1, e);
+}
+
+/**
+ * Insert an element after the last element in O(1)
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType} e - the element to be inserted
+ * @return {Status} - execution status, OVERFLOW if the list is full
+ */
+Status pushBack(LinkList *list, ElemType e) {
+    return listInsert(list, list->length + 1, e);
+}
+
+/**
+ * Delete the first element in O(1)
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType *} e - the element deleted
+ * @return {Status} - execution status, ERROR if the list is empty
+ */
+Status popFront(LinkList *list, ElemType *e) {
+    return listDelete(list, 1, e);
+}
+
+/**
+ * Delete the last element, O(1) expected on indexed lists, whose index knows the predecessor of
+ * the tail, O(n) otherwise since a singly linked list has to walk to it
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType *} e - the element deleted
+ * @return {Status} - execution status, ERROR if the list is empty
+ */
+Status popBack(LinkList *list, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    if (!list->length) { // list is empty
+        return ERROR;
+    }
+    LinkNode *node, *prev = NULL;
+    if (list->index) {
+        while (list->tail->dead) { // free tombstones at the back
+            node = list->tail;
+            list->tail = indexFindNode(list->index, node)->prev;
+            list->tail->next = NULL; // a live node is still ahead
+            indexRemove(list->index, node);
+            releaseNode(list, node);
+            list->dead--;
+        }
+        node = list->tail;
+        prev = indexFindNode(list->index, node)->prev;
+    } else { // walk to the last live node and its predecessor
+        node = NULL;
+        for (LinkNode *curr = list->head, *last = NULL; curr; last = curr, curr = curr->next) {
+            if (!curr->dead) {
+                node = curr;
+                prev = last;
+            }
+        }
+    }
+    if (prev) {
+        prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (list->tail == node) {
+        list->tail = prev;
+    }
+    if (list->index) {
+        indexRemove(list->index, node);
+    }
+    if (list->filter) {
+        filterRemove(list->filter, node->value);
+    }
+    *e = node->value;
+    releaseNode(list, node);
+    list->length--;
+    return OK;
+}
+
+/**
+ * Get the first element, O(1) unless tombstones are at the front
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType *} e - the first element
+ * @return {Status} - execution status, ERROR if the list is empty
+ */
+Status peekFront(LinkList *list, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    LinkNode *node = list->head;
+    while (node && node->dead) { // skip tombstones
+        node = node->next;
+    }
+    if (!node) { // list is empty
+        return ERROR;
+    }
+    *e = node->value;
+    return OK;
+}
+
+/**
+ * Get the last element, O(1) unless tombstones are at the back: an indexed list then steps back
+ * over them, others scan from the head
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType *} e - the last element
+ * @return {Status} - execution status, ERROR if the list is empty
+ */
+Status peekBack(LinkList *list, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    LinkNode *node = list->tail;
+    if (node && node->dead && list->index) {
+        while (node && node->dead) {
+            node = indexFindNode(list->index, node)->prev;
+        }
+    } else if (node && node->dead) {
+        node = NULL;
+        for (LinkNode *curr = list->head; curr; curr = curr->next) {
+            if (!curr->dead) {
+                node = curr;
+            }
+        }
+    }
+    if (!node) { // list is empty
+        return ERROR;
+    }
+    *e = node->value;
+    return OK;
+}
+
+/**
+ * Helper function to merge two sorted chains, stable
+ * @param {LinkNode *} a - first chain, its nodes win ties
+ * @param {LinkNode *} b - second chain
+ * @return {LinkNode *} - merged chain
+ */
+LinkNode *mergeHelper(LinkNode *a, LinkNode *b) {
+    LinkNode head;
+    LinkNode *tail = &head;
+    while (a && b) {
+        if (b->value < a->value) {
+            tail->next = b;
+            b = b->next;
+        } else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a ? a : b;
+    return head.next;
+}
+
+/**
+ * Helper function to find the last node of a chain
+ * @param {LinkNode *} node - first node of the chain
+ * @return {LinkNode *} - last node, NULL if the chain is empty
+ */
+LinkNode *lastNodeHelper(LinkNode *node) {
+    while (node && node->next) {
+        node = node->next;
+    }
+    return node;
+}
+
+/**
+ * Helper function to sort a NULL-terminated chain by bottom-up merge sort, without allocating
+ * @param {LinkNode *} node - first node of the chain
+ * @return {LinkNode *} - first node of the sorted chain
+ */
+LinkNode *sortHelper(LinkNode *node) {
+    LinkNode *bins[64] = {NULL}; // `bins[i]` is NULL or a sorted run of 2^i nodes
+    int filled = 0;
+    while (node) {
+        // take one node off the chain and carry it through the bins like a binary counter
+        LinkNode *run = node;
+        node = node->next;
+        run->next = NULL;
+        int i = 0;
+        while (i < filled && bins[i]) {
+            run = mergeHelper(bins[i], run);
+            bins[i] = NULL;
+            i++;
+        }
+        if (i == filled) {
+            filled++;
+        }
+        bins[i] = run;
+    }
+    LinkNode *result = NULL;
+    for (int i = 0; i < filled; i++) { // lower bins hold later nodes
+        if (bins[i]) {
+            result = mergeHelper(bins[i], result);
+        }
+    }
+    return result;
+}
+
+/**
+ * Helper function run by each thread of `listSort`
+ * @param {void *} argument - pointer to `SortSegment`
+ * @return {void *}
+ */
+void *sortSegmentHelper(void *argument) {
+    SortSegment *segment = (SortSegment *) argument;
+    if (segment->other) {
+        segment->head = mergeHelper(segment->head, segment->other);
+    } else {
+        segment->head = sortHelper(segment->head);
+    }
+    return NULL;
+}
+
+/**
+ * Sort a list in ascending order (stable), relinking nodes without allocating
+ * @param {LinkList *} list - pointer to list
+ * @param {int} threads - number of worker threads, 1 to sort on the calling thread
+ * @return {Status} - execution status
+ */
+Status listSort(LinkList *list, int threads) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    if (threads > SORT_MAX_THREADS) {
+        threads = SORT_MAX_THREADS;
+    }
+    if (threads <= 1 || list->length < SORT_PARALLEL_THRESHOLD) {
+        list->head = sortHelper(list->head);
+        list->tail = lastNodeHelper(list->head);
+        indexRebuildHelper(list);
+        return OK;
+    }
+
+    // cut the list into `threads` segments of about the same length
+    SortSegment segments[SORT_MAX_THREADS];
+    pthread_t workers[SORT_MAX_THREADS];
+    Boolean started[SORT_MAX_THREADS];
+    LinkNode *node = list->head;
+    for (int i = 0; i < threads; i++) {
+        int length = list->length / threads + (i < list->length % threads);
+        segments[i].head = node;
+        segments[i].other = NULL;
+        for (int j = 1; j < length; j++) {
+            node = node->next;
+        }
+        LinkNode *next = node->next;
+        node->next = NULL;
+        node = next;
+    }
+
+    // sort the segments in parallel, then merge them pairwise in parallel rounds
+    int count = threads;
+    Boolean merging = FALSE;
+    while (count > 1 || !merging) {
+        int jobs = merging ? count / 2 : count;
+        for (int i = 0; i < jobs; i++) {
+            if (merging) {
+                segments[i].head = segments[2 * i].head;
+                segments[i].other = segments[2 * i + 1].head;
+            }
+            started[i] = pthread_create(&workers[i], NULL, sortSegmentHelper, &segments[i]) == 0;
+            if (!started[i]) { // out of threads, do this job on the calling thread
+                sortSegmentHelper(&segments[i]);
+            }
+        }
+        for (int i = 0; i < jobs; i++) {
+            if (started[i]) {
+                pthread_join(workers[i], NULL);
+            }
+        }
+        if (merging) {
+            if (count % 2) { // odd segment out moves down unchanged
+                segments[jobs].head = segments[count - 1].head;
+                segments[jobs].other = NULL;
+                jobs++;
+            }
+            count = jobs;
+        }
+        merging = TRUE;
+    }
+    list->head = segments[0].head;
+    list->tail = lastNodeHelper(list->head);
+    indexRebuildHelper(list);
+    return OK;
+}
+
+/**
+ * Helper function to make the nodes of `src` releasable the way `dst` releases its own before moving them.
+ * An empty `dst` or a private arena of `src` is merged in O(number of blocks and free nodes),
+ * otherwise the live nodes of `src` are copied into nodes allocated like those of `dst`
+ * @param {LinkList *} dst - pointer to destination list
+ * @param {LinkList *} src - pointer to source list
+ * @return {Status} - execution status
+ */
+Status adoptNodesHelper(LinkList *dst, LinkList *src) {
+    if (dst->arena == src->arena) { // same allocator
+        return OK;
+    }
+    if (!dst->head && (!dst->arena || dst->arena->refCount == 1)) { // `dst` owns no node, share the arena of `src`
+        arenaRelease(dst->arena);
+        dst->arena = src->arena;
+        if (dst->arena) {
+            dst->arena->refCount++;
+        }
+        return OK;
+    }
+    NodeArena *arena = src->arena;
+    if (dst->arena && arena && arena->refCount == 1) { // move blocks and free nodes of `src` into the arena of `dst`
+        NodeBlock *last = arena->blocks;
+        if (last && !dst->arena->blocks) {
+            dst->arena->blocks = arena->blocks;
+        } else if (last) {
+            while (last->next) {
+                last = last->next;
+            }
+            // behind the current block of `dst`, which keeps serving allocations
+            last->next = dst->arena->blocks->next;
+            dst->arena->blocks->next = arena->blocks;
+        }
+        if (arena->free) {
+            LinkNode *node = arena->free;
+            while (node->next) {
+                node = node->next;
+            }
+            node->next = dst->arena->free;
+            dst->arena->free = arena->free;
+        }
+        free(arena);
+        src->arena = dst->arena;
+        src->arena->refCount++;
+        return OK;
+    }
+
+    // copy, e.g. malloc'd nodes into an arena, or nodes of an arena shared with other lists
+    LinkNode *nodes = NULL;
+    if (dst->arena && !(nodes = arenaAllocateBlock(dst->arena, src->length))) {
+        return OVERFLOW;
+    }
+    LinkNode *head = NULL, *copy = NULL;
+    LinkNode **link = &head;
+    int i = 0;
+    for (LinkNode *node = src->head; node; node = node->next) {
+        if (node->dead) { // tombstones are left behind
+            continue;
+        }
+        copy = nodes ? &nodes[i++] : (LinkNode *) malloc(sizeof(LinkNode));
+        if (!copy) { // undo, `nodes` is NULL here
+            *link = NULL;
+            while (head) {
+                LinkNode *next = head->next;
+                free(head);
+                head = next;
+            }
+            return OVERFLOW;
+        }
+        copy->value = node->value;
+        copy->dead = FALSE;
+        *link = copy;
+        link = &copy->next;
+    }
+    *link = NULL;
+    LinkNode *node = src->head;
+    while (node) { // give the originals back to where they came from
+        LinkNode *next = node->next;
+        releaseNode(src, node);
+        node = next;
+    }
+    src->head = head;
+    src->tail = copy;
+    src->dead = 0;
+    indexRebuildHelper(src);
+    return OK;
+}
+
+/**
+ * Splice a list into another, so that the first node of `src` ends up on index `i` of `dst`
+ * @param {LinkList *} dst - pointer to destination list
+ * @param {int} i - index in `dst`
+ * @param {LinkList *} src - pointer to source list, left empty
+ * @return {Status} - execution status
+ */
+Status listSplice(LinkList *dst, int i, LinkList *src) {
+    if (!dst->initialized || !src->initialized || dst == src) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > dst->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    if (dst->capacity && dst->length + src->length > dst->capacity) { // no room in `dst`
+        return OVERFLOW;
+    }
+
+    if (!src->length) { // nothing to move but tombstones
+        return listPurge(src);
+    }
+    Status status = adoptNodesHelper(dst, src);
+    if (status != OK) {
+        return status;
+    }
+    LinkNode *node = NULL; // node before the spliced chain
+    if (i > 1 && i == dst->length + 1) { // splice after tail, behind tombstones at the back too
+        node = dst->tail;
+    } else if (i > 1) { // splice in the middle
+        node = liveNodeHelper(dst, i - 1, NULL); // go to previous live node
+    }
+    LinkNode *next = node ? node->next : dst->head; // node after the spliced chain
+    src->tail->next = next;
+    if (node) {
+        node->next = src->head;
+    } else {
+        dst->head = src->head;
+    }
+    if (next == NULL) {
+        dst->tail = src->tail;
+    }
+    dst->length += src->length;
+    dst->dead += src->dead; // tombstones move along
+    if (dst->index) { // only the moved nodes are touched, and only when indexed
+        if (indexAddChain(dst->index, src->head, node, next) == OK) {
+            indexSetPrev(dst->index, next, src->tail);
+        } else {
+            indexDropHelper(dst);
+        }
+    }
+    if (src->index) {
+        indexClear(src->index);
+    }
+    filterChainHelper(src, src->head, next, FALSE);
+    filterChainHelper(dst, src->head, next, TRUE);
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+    src->dead = 0;
+    return OK;
+}
+
+/**
+ * Concatenate two lists, moving all nodes of `src` to the end of `dst` in O(1)
+ * when both allocate nodes alike or `src` has an arena of its own, see `adoptNodesHelper`
+ * @param {LinkList *} dst - pointer to destination list
+ * @param {LinkList *} src - pointer to source list, left empty
+ * @return {Status} - execution status
+ */
+Status listConcat(LinkList *dst, LinkList *src) {
+    return listSplice(dst, dst->initialized ? dst->length + 1 : 0, src);
+}
+
+/**
+ * Split a list, moving nodes from index `i` to the end into `out`
+ * @param {LinkList *} list - pointer to list
+ * @param {int} i - index of the first node to be moved
+ * @param {LinkList *} out - pointer to an empty or uninitialized list
+ * @return {Status} - execution status
+ */
+Status listSplitAt(LinkList *list, int i, LinkList *out) {
+    if (!list->initialized || list == out) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    if (!out->initialized) {
+        initializeList(out);
+    }
+    listPurge(out);
+    if (out->head) { // `out` must be empty but for tombstones
+        return ERROR;
+    }
+    if (out->arena != list->arena) { // moved nodes are released to where they were allocated
+        arenaRelease(out->arena);
+        out->arena = list->arena;
+        if (out->arena) {
+            out->arena->refCount++;
+        }
+    }
+
+    if (i == list->length + 1) { // nothing to move
+        return OK;
+    }
+    if (out->capacity && list->length - i + 1 > out->capacity) { // no room in `out`
+        return OVERFLOW;
+    }
+    LinkNode *last = NULL; // last node staying in `list`
+    int dead = 0; // tombstones staying in `list`
+    if (i == 1) { // move the whole list
+        out->head = list->head;
+        list->head = NULL;
+    } else {
+        int live = 0;
+        for (last = list->head; last->dead || ++live < i - 1; last = last->next) { // go to previous live node
+            dead += last->dead;
+        }
+        out->head = last->next;
+        last->next = NULL;
+    }
+    out->tail = list->tail;
+    out->length = list->length - i + 1;
+    out->dead = list->dead - dead;
+    list->tail = last;
+    list->length = i - 1;
+    list->dead = dead;
+    if (list->index) {
+        indexRemoveChain(list->index, out->head);
+    }
+    if (out->index && indexAddChain(out->index, out->head, NULL, NULL) != OK) {
+        indexDropHelper(out);
+    }
+    filterChainHelper(list, out->head, NULL, FALSE);
+    filterChainHelper(out, out->head, NULL, TRUE);
+    return OK;
+}
+
+/**
+ * Helper function to get a contiguous block of `n` nodes for an empty or uninitialized list
+ * @param {LinkList *} list - pointer to list
+ * @param {int} n - number of nodes
+ * @param {LinkNode **} nodes - set to the block
+ * @return {Status} - execution status
+ */
+Status blockHelper(LinkList *list, int n, LinkNode **nodes) {
+    if (n < 0) {
+        return ERROR;
+    }
+    if (!list->initialized) {
+        initializeList(list);
+    }
+    listPurge(list);
+    if (list->head) { // list must be empty
+        return ERROR;
+    }
+    if (list->capacity && n > list->capacity) { // no room
+        return OVERFLOW;
+    }
+    *nodes = NULL;
+    if (!n) {
+        return OK;
+    }
+    if (!list->arena && !(list->arena = arenaCreate())) { // the block is released by the arena
+        return OVERFLOW;
+    }
+    *nodes = arenaAllocateBlock(list->arena, n);
+    return *nodes ? OK : OVERFLOW;
+}
+
+/**
+ * Helper function to link a block of `n` nodes with values filled in as the whole list
+ * @param {LinkList *} list - pointer to an empty list
+ * @param {LinkNode *} nodes - the block
+ * @param {int} n - number of nodes
+ * @return {void}
+ */
+void linkBlockHelper(LinkList *list, LinkNode *nodes, int n) {
+    if (!n) {
+        return;
+    }
+    for (int i = 0; i < n - 1; i++) {
+        nodes[i].dead = FALSE;
+        nodes[i].next = &nodes[i + 1];
+    }
+    nodes[n - 1].dead = FALSE;
+    nodes[n - 1].next = NULL;
+    list->head = nodes;
+    list->tail = &nodes[n - 1];
+    list->length = n;
+    indexRebuildHelper(list);
+    filterChainHelper(list, list->head, NULL, TRUE);
+}
+
+/**
+ * Build a list from an array in one pass, with nodes in one contiguous block of its arena
+ * @param {LinkList *} list - pointer to an empty or uninitialized list
+ * @param {ElemType *} values - values in list order
+ * @param {int} n - number of values
+ * @return {Status} - execution status
+ */
+Status listFromArray(LinkList *list, ElemType *values, int n) {
+    LinkNode *nodes;
+    Status status = blockHelper(list, n, &nodes);
+    if (status != OK) {
+        return status;
+    }
+    for (int i = 0; i < n; i++) {
+        nodes[i].value = values[i];
+    }
+    linkBlockHelper(list, nodes, n);
+    return OK;
+}
+
+/**
+ * Copy values of a list into an array
+ * @param {LinkList *} list - pointer to list
+ * @param {ElemType *} out - array with room for `listLength(list)` values
+ * @return {Status} - execution status
+ */
+Status listToArray(LinkList *list, ElemType *out) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    for (LinkNode *node = list->head; node; node = node->next) {
+        if (!node->dead) {
+            *out++ = node->value;
+        }
+    }
+    return OK;
+}
+
+/**
+ * Helper function to restore the min-heap of `listMergeSorted` below slot `i`,
+ * ties are broken by the index of source list to keep the merge stable
+ * @param {LinkNode **} heap - heads of remaining runs
+ * @param {int *} sources - index of source list of each run
+ * @param {int} size - size of heap
+ * @param {int} i - slot
+ * @return {void}
+ */
+void siftDownHelper(LinkNode **heap, int *sources, int size, int i) {
+    while (TRUE) {
+        int least = i;
+        for (int child = 2 * i + 1; child <= 2 * i + 2 && child < size; child++) {
+            if (heap[child]->value < heap[least]->value
+                || (heap[child]->value == heap[least]->value && sources[child] < sources[least])) {
+                least = child;
+            }
+        }
+        if (least == i) {
+            return;
+        }
+        LinkNode *node = heap[i];
+        heap[i] = heap[least];
+        heap[least] = node;
+        int source = sources[i];
+        sources[i] = sources[least];
+        sources[least] = source;
+        i = least;
+    }
+}
+
+/**
+ * Merge `k` lists sorted in ascending order into one list in O(n log k), leaving them untouched
+ * @param {LinkList *} list - pointer to an empty or uninitialized list, not one of `lists`
+ * @param {LinkList **} lists - lists to be merged
+ * @param {int} k - number of lists
+ * @return {Status} - execution status
+ */
+Status listMergeSorted(LinkList *list, LinkList **lists, int k) {
+    if (k < 0) {
+        return ERROR;
+    }
+    long long total = 0;
+    for (int i = 0; i < k; i++) {
+        if (!lists[i]->initialized || lists[i] == list) {
+            return ERROR;
+        }
+        listPurge(lists[i]);
+        total += lists[i]->length;
+    }
+    if (total > INT32_MAX) {
+        return OVERFLOW;
+    }
+    LinkNode **heap = (LinkNode **) malloc((k ? k : 1) * sizeof(LinkNode *));
+    int *sources = (int *) malloc((k ? k : 1) * sizeof(int));
+    LinkNode *nodes;
+    Status status = heap && sources ? blockHelper(list, (int) total, &nodes) : OVERFLOW;
+    if (status != OK) {
+        free(heap);
+        free(sources);
+        return status;
+    }
+    int size = 0;
+    for (int i = 0; i < k; i++) {
+        if (lists[i]->head) {
+            heap[size] = lists[i]->head;
+            sources[size++] = i;
+        }
+    }
+    for (int i = size / 2 - 1; i >= 0; i--) {
+        siftDownHelper(heap, sources, size, i);
+    }
+    for (int n = 0; size; n++) { // take the least head, then replace it by its successor
+        nodes[n].value = heap[0]->value;
+        heap[0] = heap[0]->next;
+        if (!heap[0]) {
+            heap[0] = heap[--size];
+            sources[0] = sources[size];
+        }
+        siftDownHelper(heap, sources, size, 0);
+    }
+    linkBlockHelper(list, nodes, (int) total);
+    free(heap);
+    free(sources);
+    return OK;
+}
+
+/**
+ * Select a list
+ * @param {LinkList **} currentList - pointer to `LinkList *currentList`
+ * @param {LinkList *} nextList - pointer to nextList
+ * @return {Status} - execution status
+ */
+Status selectList(LinkList **currentList, LinkList *nextList) {
+    *currentList = nextList;
+    return OK;
+}
+
+/**
+ * Helper function to write out the buffer of a stream
+ * @param {StreamBuffer *} stream - pointer to a stream
+ * @return {void}
+ */
+void streamFlush(StreamBuffer *stream) {
+    if (stream->length && fwrite(stream->buffer, 1, stream->length, stream->fp) != stream->length) {
+        stream->failed = TRUE;
+    }
+    stream->length = 0;
+}
+
+/**
+ * Helper function to append bytes to a stream
+ * @param {StreamBuffer *} stream - pointer to a stream
+ * @param {const void *} data - bytes
+ * @param {size_t} size - number of bytes, at most `STREAM_BUFFER_SIZE`
+ * @return {void}
+ */
+void streamWrite(StreamBuffer *stream, const void *data, size_t size) {
+    if (STREAM_BUFFER_SIZE - stream->length < size) {
+        streamFlush(stream);
+    }
+    memcpy(stream->buffer + stream->length, data, size);
+    stream->length += size;
+}
+
+/**
+ * Helper function to append an integer in decimal followed by `terminator` to a stream
+ * @param {StreamBuffer *} stream - pointer to a stream
+ * @param {int} value - integer
+ * @param {char} terminator - character written after the integer
+ * @return {void}
+ */
+void streamWriteInt(StreamBuffer *stream, int value, char terminator) {
+    if (STREAM_BUFFER_SIZE - stream->length < 16) {
+        streamFlush(stream);
+    }
+    char digits[12];
+    int n = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+    do { // digits come out backwards
+        digits[n++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    char *out = stream->buffer + stream->length;
+    if (value < 0) {
+        *out++ = '-';
+    }
+    while (n) {
+        *out++ = digits[--n];
+    }
+    *out++ = terminator;
+    stream->length = out - stream->buffer;
+}
+
+/**
+ * Helper function to refill the buffer of a stream
+ * @param {StreamBuffer *} stream - pointer to a stream
+ * @return {Boolean} - FALSE at the end of file
+ */
+Boolean streamFill(StreamBuffer *stream) {
+    stream->length = fread(stream->buffer, 1, STREAM_BUFFER_SIZE, stream->fp);
+    stream->position = 0;
+    return stream->length > 0;
+}
+
+/**
+ * Helper function to read a decimal integer from a stream, skipping whitespace
+ * @param {StreamBuffer *} stream - pointer to a stream
+ * @param {int *} value - pointer to the integer
+ * @return {Boolean} - FALSE at the end of file or on malformed input, which also sets `failed`
+ */
+Boolean streamReadInt(StreamBuffer *stream, int *value) {
+    int c;
+    do { // skip whitespace
+        if (stream->position == stream->length && !streamFill(stream)) {
+            return FALSE;
+        }
+        c = (unsigned char) stream->buffer[stream->position++];
+    } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+
+    Boolean negative = c == '-';
+    if (negative) {
+        if (stream->position == stream->length && !streamFill(stream)) {
+            stream->failed = TRUE;
+            return FALSE;
+        }
+        c = (unsigned char) stream->buffer[stream->position++];
+    }
+    if (c < '0' || c > '9') {
+        stream->failed = TRUE;
+        return FALSE;
+    }
+    long long magnitude = 0;
+    while (c >= '0' && c <= '9') {
+        magnitude = magnitude * 10 + (c - '0');
+        if (magnitude > (negative ? -(long long) INT32_MIN : INT32_MAX)) { // out of range of int
+            stream->failed = TRUE;
+            return FALSE;
+        }
+        if (stream->position == stream->length && !streamFill(stream)) {
+            break;
+        }
+        c = (unsigned char) stream->buffer[stream->position++];
+    }
+    *value = (int) (negative ? -magnitude : magnitude);
+    return TRUE;
+}
+
+/**
+ * Helper function to fold a value into a checksum of binary list files
+ * @param {uint64_t} checksum - checksum so far
+ * @param {ElemType} value - value
+ * @return {uint64_t}
+ */
+uint64_t checksumHelper(uint64_t checksum, ElemType value) {
+    return (checksum ^ (uint32_t) value) * 0x100000001B3ull;
+}
+
+/**
+ * Load data from a file, in text or binary format (detected by its header)
+ * @param {LinkList *} list - list which has NOT been initialized
+ * @param {const char *} filename - file name
+ * @return {Status} - execution status
+ */
+Status loadDataFrom(LinkList *list, const char *filename) {
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) { // file doesn't exist
+        printf("File doesn't exist!\n");
+        return ERROR;
+    }
+    Status result = initializeList(list);
+    if (result == ERROR) {
+        printf("This list has ALREADY been initialized!\n");
+        fclose(fp);
+        return ERROR;
+    } else if (result == OVERFLOW) {
+        printf("Overflow!\n");
+        fclose(fp);
+        return ERROR;
+    }
+
+    StreamBuffer stream = {fp, (char *) malloc(STREAM_BUFFER_SIZE), 0, 0, FALSE};
+    if (!stream.buffer) {
+        fclose(fp);
+        destroyList(list);
+        return OVERFLOW;
+    }
+    ListFileHeader header;
+    uint32_t magic = LIST_MAGIC;
+    Boolean binary = streamFill(&stream) && stream.length >= sizeof(header)
+                     && memcmp(stream.buffer, &magic, sizeof(magic)) == 0;
+    if (binary) { // header, then packed values read in blocks
+        memcpy(&header, stream.buffer, sizeof(header));
+        if (header.length < 0 || header.length > INT32_MAX || fseek(fp, sizeof(header), SEEK_SET) != 0) {
+            stream.failed = TRUE;
+        } else {
+            printf("Loading list of length %lld...\n", (long long) header.length);
+        }
+        ElemType *values = (ElemType *) stream.buffer;
+        uint64_t checksum = 0;
+        int64_t count = 0;
+        size_t read;
+        while (!stream.failed && result == OK && count < header.length
+               && (read = fread(values, sizeof(ElemType), STREAM_BUFFER_SIZE / sizeof(ElemType), fp)) > 0) {
+            for (size_t i = 0; i < read && count < header.length && result == OK; i++, count++) {
+                checksum = checksumHelper(checksum, values[i]);
+                result = listInsert(list, list->length + 1, values[i]); // O(1) append
+            }
+        }
+        if (result == OK && (count != header.length || checksum != header.checksum)) {
+            stream.failed = TRUE;
+        }
+    } else { // "length\n\n" then one value per line
+        int length = 0;
+        stream.position = 0;
+        if (stream.length && streamReadInt(&stream, &length)) {
+            if (length < 0) {
+                printf("Length is illegal!\n");
+                stream.failed = TRUE;
+            } else {
+                printf("Loading list of length %d...\n", length);
+            }
+        }
+        ElemType element;
+        while (!stream.failed && result == OK && streamReadInt(&stream, &element)) { // while element value exists
+            result = listInsert(list, list->length + 1, element); // insert into the end of list
+        }
+    }
+    free(stream.buffer);
+    fclose(fp);
+    if (result != OK) {
+        printf("Overflow!\n");
+        destroyList(list);
+        return OVERFLOW;
+    }
+    if (stream.failed) {
+        printf("File is broken!\n");
+        destroyList(list);
+        return ERROR;
+    }
+    return OK;
+}
+
+/**
+ * Load data from `data.txt`
+ * @param {LinkList *} list - list
+ * @return {Status} - execution status
+ */
+Status loadData(LinkList *list) {
+    return loadDataFrom(list, "data.txt");
+}
+
+/**
+ * Save data to a file through one large buffer.
+ * The file is written under a temporary name and renamed over `filename` only when complete
+ * @param {LinkList *} list - list
+ * @param {const char *} filename - file name
+ * @param {Boolean} binary - write packed values with a checksummed header instead of text
+ * @return {Status} - execution status
+ */
+Status saveDataAs(LinkList *list, const char *filename, Boolean binary) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+
+    char temporary[FILENAME_MAX];
+    if (snprintf(temporary, sizeof(temporary), "%s.tmp", filename) >= (int) sizeof(temporary)) {
+        return ERROR;
+    }
+    FILE *fp = fopen(temporary, "wb");
+    if (fp == NULL) { // can't create file
+        return ERROR;
+    }
+    StreamBuffer stream = {fp, (char *) malloc(STREAM_BUFFER_SIZE), 0, 0, FALSE};
+    if (!stream.buffer) {
+        fclose(fp);
+        remove(temporary);
+        return OVERFLOW;
+    }
+
+    if (binary) {
+        ListFileHeader header = {LIST_MAGIC, 1, list->length, 0};
+        streamWrite(&stream, &header, sizeof(header)); // checksum is patched in below
+        for (LinkNode *node = list->head; node; node = node->next) {
+            header.checksum = checksumHelper(header.checksum, node->value);
+            streamWrite(&stream, &node->value, sizeof(ElemType));
+        }
+        streamFlush(&stream);
+        if (fseek(fp, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, fp) != 1) {
+            stream.failed = TRUE;
+        }
+    } else {
+        streamWriteInt(&stream, list->length, '\n');
+        streamWrite(&stream, "\n", 1);
+        for (LinkNode *node = list->head; node; node = node->next) {
+            streamWriteInt(&stream, node->value, '\n');
+        }
+        streamFlush(&stream);
+    }
+    free(stream.buffer);
+    if (fflush(fp) != 0) {
+        stream.failed = TRUE;
+    }
+#ifndef WIN32
+    if (!stream.failed && fsync(fileno(fp)) != 0) { // data must be on disk before the rename
+        stream.failed = TRUE;
+    }
+#endif
+    if (fclose(fp) != 0) {
+        stream.failed = TRUE;
+    }
+    if (stream.failed) {
+        remove(temporary);
+        return ERROR;
+    }
+#ifdef WIN32
+    remove(filename); // rename doesn't replace existing files on windows
+#endif
+    if (rename(temporary, filename) != 0) {
+        remove(temporary);
+        return ERROR;
+    }
+    return OK;
+}
+
+/**
+ * Save data to `data.txt`
+ * @param {LinkList *} list - list
+ * @return {Status} - execution status
+ */
+Status saveData(LinkList *list) {
+    return saveDataAs(list, "data.txt", FALSE);
+}
+
+/**
+ * Initialize a persistent list as an empty version
+ * @param {PersistentList *} version - pointer to a version
+ * @return {Status} - execution status
+ */
+Status initializePersistentList(PersistentList *version) {
+    if (version->initialized) { // already exists
+        return ERROR;
+    }
+    version->head = NULL;
+    version->length = 0;
+    version->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Helper function to take a reference to a node
+ * @param {PersistentNode *} node - node, may be NULL
+ * @return {PersistentNode *} - the node
+ */
+PersistentNode *persistentRetain(PersistentNode *node) {
+    if (node) {
+        node->refCount++;
+    }
+    return node;
+}
+
+/**
+ * Helper function to drop a reference to a node, freeing the chain as far as it isn't shared
+ * @param {PersistentNode *} node - node, may be NULL
+ * @return {void}
+ */
+void persistentRelease(PersistentNode *node) {
+    // iterative, so dropping a long version doesn't recurse once per node
+    while (node && --node->refCount == 0) {
+        PersistentNode *next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+/**
+ * Helper function to make `version` refer to a chain whose reference was already taken
+ * @param {PersistentList *} version - pointer to a version, may be uninitialized
+ * @param {PersistentNode *} head - first node of the chain
+ * @param {int} length - length of the chain
+ * @return {void}
+ */
+void persistentAssign(PersistentList *version, PersistentNode *head, int length) {
+    if (version->initialized) {
+        persistentRelease(version->head);
+    }
+    version->head = head;
+    version->length = length;
+    version->initialized = TRUE;
+}
+
+/**
+ * Destroy a version, nodes shared with other versions are kept
+ * @param {PersistentList *} version - pointer to a version
+ * @return {Status} - execution status
+ */
+Status destroyPersistentList(PersistentList *version) {
+    if (!version->initialized) { // version doesn't exist
+        return ERROR;
+    }
+    persistentRelease(version->head);
+    version->head = NULL;
+    version->length = 0;
+    version->initialized = FALSE;
+    return OK;
+}
+
+/**
+ * Make `dst` the same version as `src` in O(1)
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized
+ * @param {PersistentList *} src - pointer to a version
+ * @return {Status} - execution status
+ */
+Status persistentShare(PersistentList *dst, PersistentList *src) {
+    if (!src->initialized) { // version doesn't exist
+        return ERROR;
+    }
+    persistentAssign(dst, persistentRetain(src->head), src->length);
+    return OK;
+}
+
+/**
+ * Make `dst` the version of `src` with the elements from index `i` on, sharing all of them
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized
+ * @param {PersistentList *} src - pointer to a version
+ * @param {int} i - index of the first element kept
+ * @return {Status} - execution status
+ */
+Status persistentSuffix(PersistentList *dst, PersistentList *src, int i) {
+    if (!src->initialized) { // version doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > src->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    PersistentNode *node = src->head;
+    for (int j = 1; j < i; j++) {
+        node = node->next;
+    }
+    persistentAssign(dst, persistentRetain(node), src->length - i + 1);
+    return OK;
+}
+
+/**
+ * Make `dst` the version of `src` with `e` inserted on index `i`:
+ * nodes before `i` are copied, the rest is shared
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized or `src`
+ * @param {PersistentList *} src - pointer to a version
+ * @param {int} i - index of element to be inserted
+ * @param {ElemType} e - the element to be inserted
+ * @return {Status} - execution status
+ */
+Status persistentInsert(PersistentList *dst, PersistentList *src, int i, ElemType e) {
+    if (!src->initialized) { // version doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > src->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    PersistentNode head;
+    PersistentNode *last = &head;
+    PersistentNode *node = src->head;
+    for (int j = 1; j <= i; j++) {
+        PersistentNode *newNode = (PersistentNode *) malloc(sizeof(PersistentNode));
+        if (!newNode) {
+            last->next = NULL;
+            persistentRelease(head.next);
+            return OVERFLOW;
+        }
+        newNode->refCount = 1;
+        if (j < i) { // copy the prefix
+            newNode->value = node->value;
+            node = node->next;
+        } else {
+            newNode->value = e;
+        }
+        last->next = newNode;
+        last = newNode;
+    }
+    last->next = persistentRetain(node); // share the suffix
+    persistentAssign(dst, head.next, src->length + 1);
+    return OK;
+}
+
+/**
+ * Make `dst` the version of `src` without the element on index `i`:
+ * nodes before `i` are copied, the rest is shared
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized or `src`
+ * @param {PersistentList *} src - pointer to a version
+ * @param {int} i - index of element to be deleted
+ * @param {ElemType *} e - the element to be deleted
+ * @return {Status} - execution status
+ */
+Status persistentDelete(PersistentList *dst, PersistentList *src, int i, ElemType *e) {
+    if (!src->initialized) { // version doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > src->length) { // index is illegal
+        return ERROR;
+    }
+
+    PersistentNode head;
+    PersistentNode *last = &head;
+    PersistentNode *node = src->head;
+    for (int j = 1; j < i; j++) { // copy the prefix
+        PersistentNode *newNode = (PersistentNode *) malloc(sizeof(PersistentNode));
+        if (!newNode) {
+            last->next = NULL;
+            persistentRelease(head.next);
+            return OVERFLOW;
+        }
+        newNode->refCount = 1;
+        newNode->value = node->value;
+        last->next = newNode;
+        last = newNode;
+        node = node->next;
+    }
+    *e = node->value;
+    last->next = persistentRetain(node->next); // share the suffix
+    persistentAssign(dst, head.next, src->length - 1);
+    return OK;
+}
+
+/**
+ * Make `dst` the version of `src` with `e` prepended, in O(1)
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized or `src`
+ * @param {PersistentList *} src - pointer to a version
+ * @param {ElemType} e - the element to be prepended
+ * @return {Status} - execution status
+ */
+Status persistentPush(PersistentList *dst, PersistentList *src, ElemType e) {
+    return persistentInsert(dst, src, 1, e);
+}
+
+/**
+ * Make `dst` the version of `src` without its first element, in O(1)
+ * @param {PersistentList *} dst - pointer to a version, may be uninitialized or `src`
+ * @param {PersistentList *} src - pointer to a version
+ * @param {ElemType *} e - the first element
+ * @return {Status} - execution status
+ */
+Status persistentPop(PersistentList *dst, PersistentList *src, ElemType *e) {
+    return persistentDelete(dst, src, 1, e);
+}
+
+/**
+ * Get element's value on specified index of a version
+ * @param {PersistentList *} version - pointer to a version
+ * @param {int} i - index
+ * @param {ElemType *} e - pointer to element
+ * @return {Status} - execution status
+ */
+Status persistentGetElem(PersistentList *version, int i, ElemType *e) {
+    if (!version->initialized) { // version doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > version->length) { // index is illegal
+        return ERROR;
+    }
+
+    PersistentNode *node = version->head;
+    for (int j = 1; j < i; j++) {
+        node = node->next;
+    }
+    *e = node->value;
+    return OK;
+}
+
+/**
+ * Take a snapshot of a list as a new version
+ * @param {PersistentList *} version - pointer to a version, may be uninitialized
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status persistentFromList(PersistentList *version, LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    PersistentNode head;
+    PersistentNode *last = &head;
+    for (LinkNode *node = list->head; node; node = node->next) {
+        PersistentNode *newNode = (PersistentNode *) malloc(sizeof(PersistentNode));
+        if (!newNode) {
+            last->next = NULL;
+            persistentRelease(head.next);
+            return OVERFLOW;
+        }
+        newNode->refCount = 1;
+        newNode->value = node->value;
+        last->next = newNode;
+        last = newNode;
+    }
+    last->next = NULL;
+    persistentAssign(version, head.next, list->length);
+    return OK;
+}
+
+/**
+ * Restore a version into a list which has NOT been initialized
+ * @param {LinkList *} list - pointer to list
+ * @param {PersistentList *} version - pointer to a version
+ * @return {Status} - execution status
+ */
+Status persistentToList(LinkList *list, PersistentList *version) {
+    if (!version->initialized || initializeList(list) != OK) {
+        return ERROR;
+    }
+    for (PersistentNode *node = version->head; node; node = node->next) {
+        listInsert(list, list->length + 1, node->value); // O(1) append
+    }
+    return OK;
+}
+
+/**
+ * Initialize a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {int} capacity - number of slots to reserve
+ * @return {Status} - execution status
+ */
+Status initializeCompactList(CompactList *list, int capacity) {
+    if (list->initialized) { // already exists
+        return ERROR;
+    }
+    if (capacity < 1) {
+        capacity = 1;
+    }
+
+    list->values = (ElemType *) malloc(capacity * sizeof(ElemType));
+    list->next = (uint32_t *) malloc(capacity * sizeof(uint32_t));
+    if (!list->values || !list->next) {
+        free(list->values);
+        free(list->next);
+        return OVERFLOW;
+    }
+    // chain all slots into the free list
+    for (int i = 0; i < capacity - 1; i++) {
+        list->next[i] = (uint32_t) i + 1;
+    }
+    list->next[capacity - 1] = COMPACT_NULL;
+    list->head = COMPACT_NULL;
+    list->tail = COMPACT_NULL;
+    list->freeHead = 0;
+    list->capacity = (uint32_t) capacity;
+    list->length = 0;
+    list->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Destroy a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @return {Status} - execution status
+ */
+Status destroyCompactList(CompactList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    // all nodes live in two arrays, so there is nothing to free one by one
+    free(list->values);
+    free(list->next);
+    list->values = NULL;
+    list->next = NULL;
+    list->capacity = 0;
+    list->length = 0;
+    list->initialized = FALSE;
+    return OK;
+}
+
+/**
+ * Helper function to take a slot from the free list, growing the arrays if necessary
+ * @param {CompactList *} list - pointer to a compact list
+ * @return {uint32_t} - index of the slot, `COMPACT_NULL` on overflow
+ */
+uint32_t compactAllocate(CompactList *list) {
+    if (list->freeHead == COMPACT_NULL) { // no free slot, double the arrays
+        uint32_t capacity = list->capacity;
+        if (capacity >= COMPACT_NULL / 2) {
+            return COMPACT_NULL;
+        }
+        ElemType *values = (ElemType *) realloc(list->values, 2 * capacity * sizeof(ElemType));
+        if (!values) {
+            return COMPACT_NULL;
+        }
+        list->values = values;
+        uint32_t *next = (uint32_t *) realloc(list->next, 2 * capacity * sizeof(uint32_t));
+        if (!next) {
+            return COMPACT_NULL;
+        }
+        list->next = next;
+        // links are indices, so growing never invalidates existing nodes
+        for (uint32_t i = capacity; i < 2 * capacity - 1; i++) {
+            list->next[i] = i + 1;
+        }
+        list->next[2 * capacity - 1] = COMPACT_NULL;
+        list->freeHead = capacity;
+        list->capacity = 2 * capacity;
+    }
+    uint32_t slot = list->freeHead;
+    list->freeHead = list->next[slot];
+    return slot;
+}
+
+/**
+ * Insert an element to a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {int} i - index of element to be inserted
+ * @param {ElemType} e - the element to be inserted
+ * @return {Status} - execution status
+ */
+Status compactListInsert(CompactList *list, int i, ElemType e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length + 1) { // index is illegal
+        return ERROR;
+    }
+
+    uint32_t slot = compactAllocate(list);
+    if (slot == COMPACT_NULL) {
+        return OVERFLOW;
+    }
+    list->values[slot] = e;
+    if (i == 1) { // insert to index 1
+        list->next[slot] = list->head;
+        list->head = slot;
+    } else if (i == list->length + 1) { // append after tail
+        list->next[slot] = COMPACT_NULL;
+        list->next[list->tail] = slot;
+    } else { // insert to other index
+        uint32_t node = list->head;
+        for (int j = 1; j < i - 1; j++) { // go to previous node
+            node = list->next[node];
+        }
+        list->next[slot] = list->next[node];
+        list->next[node] = slot;
+    }
+    if (list->next[slot] == COMPACT_NULL) {
+        list->tail = slot;
+    }
+    list->length++;
+    return OK;
+}
+
+/**
+ * Delete the specified element from a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {int} i - index of element to be deleted
+ * @param {ElemType *} e - the element to be deleted
+ * @return {Status} - execution status
+ */
+Status compactListDelete(CompactList *list, int i, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length) { // index is illegal
+        return ERROR;
+    }
+
+    uint32_t slot, prev = COMPACT_NULL;
+    if (i == 1) { // delete index 1
+        slot = list->head;
+        list->head = list->next[slot];
+    } else { // delete other index
+        prev = list->head;
+        for (int j = 1; j < i - 1; j++) { // go to previous node
+            prev = list->next[prev];
+        }
+        slot = list->next[prev];
+        list->next[prev] = list->next[slot];
+    }
+    if (slot == list->tail) {
+        list->tail = prev;
+    }
+    *e = list->values[slot];
+    // return the slot to the free list
+    list->next[slot] = list->freeHead;
+    list->freeHead = slot;
+    list->length--;
+    return OK;
+}
+
+/**
+ * Get element's value on specified index of a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {int} i - index
+ * @param {ElemType *} e - pointer to element
+ * @return {Status} - execution status
+ */
+Status compactGetElem(CompactList *list, int i, ElemType *e) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    if (i < 1 || i > list->length) { // index is illegal
+        return ERROR;
+    }
+
+    uint32_t node = list->head;
+    for (int j = 1; j < i; j++) {
+        node = list->next[node];
+    }
+    *e = list->values[node];
+    return OK;
+}
+
+/**
+ * Traverse a compact list
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {void (*)(ElemType)} visitor - visit function
+ * @return {Status} - execution status
+ */
+Status compactListTraverse(CompactList *list, void (*visitor)(ElemType)) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    for (uint32_t node = list->head; node != COMPACT_NULL; node = list->next[node]) {
+        visitor(list->values[node]);
+    }
+    return OK;
+}
+
+/**
+ * Build a compact list from a linked list
+ * @param {CompactList *} compact - pointer to an uninitialized compact list
+ * @param {LinkList *} list - pointer to list
+ * @return {Status} - execution status
+ */
+Status listToCompact(CompactList *compact, LinkList *list) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+    listPurge(list);
+    Status status = initializeCompactList(compact, list->length);
+    if (status != OK) {
+        return status;
+    }
+    // nodes are laid out in list order, so slot `k` links to slot `k + 1`
+    uint32_t k = 0;
+    for (LinkNode *node = list->head; node; node = node->next) {
+        compact->values[k++] = node->value;
+    }
+    if (k) {
+        compact->next[k - 1] = COMPACT_NULL;
+        compact->head = 0;
+        compact->tail = k - 1;
+    }
+    compact->freeHead = k < compact->capacity ? k : COMPACT_NULL;
+    compact->length = (int) k;
+    return OK;
+}
+
+/**
+ * Save a compact list to a file as raw arrays
+ * @param {CompactList *} list - pointer to a compact list
+ * @param {const char *} filename - file name
+ * @return {Status} - execution status
+ */
+Status saveCompactList(CompactList *list, const char *filename) {
+    if (!list->initialized) { // list doesn't exist
+        return ERROR;
+    }
+
+    FILE *fp = fopen(filename, "wb");
+    if (fp == NULL) {
+        return ERROR;
+    }
+    // header, then both arrays as they are in memory: links are indices, so no fix-up is needed
+    uint32_t header[5] = {COMPACT_MAGIC, list->capacity, list->head, list->tail, list->freeHead};
+    int32_t length = list->length;
+    size_t capacity = list->capacity;
+    int failed = fwrite(header, sizeof(header), 1, fp) != 1
+                 || fwrite(&length, sizeof(length), 1, fp) != 1
+                 || fwrite(list->values, sizeof(ElemType), capacity, fp) != capacity
+                 || fwrite(list->next, sizeof(uint32_t), capacity, fp) != capacity;
+    failed |= fclose(fp) != 0;
+    return failed ? ERROR : OK;
+}
+
+/**
+ * Helper function to check the links of a loaded compact list: the chain from `head` must hold
+ * exactly `length` slots ending at `tail`, and the free list all other slots, without cycles
+ * @param {CompactList *} list - pointer to a compact list
+ * @return {Status} - execution status, ERROR if the links are broken
+ */
+Status compactValidHelper(CompactList *list) {
+    uint8_t *seen = (uint8_t *) calloc(list->capacity, sizeof(uint8_t));
+    if (!seen) {
+        return OVERFLOW;
+    }
+    Status status = OK;
+    uint32_t count = 0, last = COMPACT_NULL;
+    for (uint32_t node = list->head; node != COMPACT_NULL; node = list->next[node]) {
+        if (node >= list->capacity || seen[node]) { // out of range or cycle
+            status = ERROR;
+            break;
+        }
+        seen[node] = 1;
+        last = node;
+        count++;
+    }
+    if (status == OK && (count != (uint32_t) list->length || last != list->tail)) {
+        status = ERROR;
+    }
+    for (uint32_t node = list->freeHead; status == OK && node != COMPACT_NULL; node = list->next[node]) {
+        if (node >= list->capacity || seen[node]) { // out of range, cycle, or also in the chain
+            status = ERROR;
+            break;
+        }
+        seen[node] = 1;
+        count++;
+    }
+    if (status == OK && count != list->capacity) { // slots on neither list would be lost
+        status = ERROR;
+    }
+    free(seen);
+    return status;
+}
+
+/**
+ * Load a compact list from a file written by `saveCompactList`
+ * @param {CompactList *} list - pointer to an uninitialized compact list
+ * @param {const char *} filename - file name
+ * @return {Status} - execution status
+ */
+Status loadCompactList(CompactList *list, const char *filename) {
+    if (list->initialized) { // already exists
+        return ERROR;
+    }
+
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        return ERROR;
+    }
+    uint32_t header[5];
+    int32_t length;
+    if (fread(header, sizeof(header), 1, fp) != 1 || fread(&length, sizeof(length), 1, fp) != 1
+        || header[0] != COMPACT_MAGIC || header[1] == 0 || header[1] > INT32_MAX
+        || length < 0 || (uint32_t) length > header[1]) {
+        fclose(fp);
+        return ERROR;
+    }
+    Status status = initializeCompactList(list, (int) header[1]);
+    if (status != OK) {
+        fclose(fp);
+        return status;
+    }
+    size_t capacity = header[1];
+    if (fread(list->values, sizeof(ElemType), capacity, fp) != capacity
+        || fread(list->next, sizeof(uint32_t), capacity, fp) != capacity) {
+        fclose(fp);
+        destroyCompactList(list);
+        return ERROR;
+    }
+    fclose(fp);
+    list->head = header[2];
+    list->tail = header[3];
+    list->freeHead = header[4];
+    list->length = length;
+    status = compactValidHelper(list); // indices come from the file, never follow them unchecked
+    if (status != OK) {
+        destroyCompactList(list);
+    }
+    return status;
+}
+
+/**
+ * Save a list to `data.bin` in compact form
+ * @param {LinkList *} list - list
+ * @return {Status} - execution status
+ */
+Status saveCompactData(LinkList *list) {
+    CompactList compact;
+    compact.initialized = FALSE;
+    Status status = listToCompact(&compact, list);
+    if (status != OK) {
+        return ERROR;
+    }
+    status = saveCompactList(&compact, "data.bin");
+    destroyCompactList(&compact);
+    return status;
+}
+
+/**
+ * Load a list from `data.bin` written by `saveCompactData`
+ * @param {LinkList *} list - list
+ * @return {Status} - execution status
+ */
+Status loadCompactData(LinkList *list) {
+    CompactList compact;
+    compact.initialized = FALSE;
+    if (loadCompactList(&compact, "data.bin") != OK) {
+        printf("File doesn't exist or is broken!\n");
+        return ERROR;
+    }
+    if (initializeList(list) != OK) {
+        printf("This list has ALREADY been initialized!\n");
+        destroyCompactList(&compact);
+        return ERROR;
+    }
+    printf("Loading list of length %d...\n", compact.length);
+    // rebuild the chain from the tail so every insertion is at index 1
+    ElemType *values = (ElemType *) malloc((compact.length + 1) * sizeof(ElemType));
+    if (!values) {
+        destroyCompactList(&compact);
+        destroyList(list);
+        return OVERFLOW;
+    }
+    int k = 0;
+    for (uint32_t node = compact.head; node != COMPACT_NULL; node = compact.next[node]) {
+        values[k++] = compact.values[node];
+    }
+    while (k > 0) {
+        listInsert(list, 1, values[--k]);
+    }
+    free(values);
+    destroyCompactList(&compact);
+    return OK;
+}
+
+/**
+ * Initialize an epoch domain
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @param {void (*)(void *, void *, int)} reclaim - function releasing a retired node, given the node,
+ * `context` and the slot of the thread releasing it
+ * @param {void *} context - argument passed to `reclaim`
+ * @return {void}
+ */
+void initializeEpochDomain(EpochDomain *domain, void (*reclaim)(void *, void *, int), void *context) {
+    atomic_init(&domain->epoch, 0);
+    atomic_init(&domain->threads, 0);
+    domain->reclaim = reclaim;
+    domain->context = context;
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        EpochRecord *record = &domain->records[i];
+        atomic_init(&record->epoch, 0);
+        atomic_init(&record->active, FALSE);
+        record->lastEpoch = 0;
+        record->retiredCount = 0;
+        for (int j = 0; j < 3; j++) {
+            record->limbo[j].items = NULL;
+            record->limbo[j].count = 0;
+            record->limbo[j].capacity = 0;
+        }
+    }
+}
+
+/**
+ * Helper function to reclaim every node of a limbo bag
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @param {LimboBag *} bag - bag to be emptied
+ * @param {int} thread - thread slot
+ * @return {void}
+ */
+void epochReclaimBag(EpochDomain *domain, LimboBag *bag, int thread) {
+    for (int i = 0; i < bag->count; i++) {
+        domain->reclaim(bag->items[i], domain->context, thread);
+    }
+    bag->count = 0;
+}
+
+/**
+ * Reclaim all retired nodes and release limbo bags, only when no thread uses the domain
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @return {void}
+ */
+void destroyEpochDomain(EpochDomain *domain) {
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        for (int j = 0; j < 3; j++) {
+            epochReclaimBag(domain, &domain->records[i].limbo[j], i);
+            free(domain->records[i].limbo[j].items);
+            domain->records[i].limbo[j].items = NULL;
+            domain->records[i].limbo[j].capacity = 0;
+        }
+    }
+}
+
+/**
+ * Register the calling thread in an epoch domain
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @return {int} - thread slot, ERROR if all slots are taken
+ */
+int epochRegister(EpochDomain *domain) {
+    int slot = atomic_fetch_add(&domain->threads, 1);
+    return slot < EPOCH_MAX_THREADS ? slot : ERROR;
+}
+
+/**
+ * Enter a critical section: nodes reachable now won't be reclaimed until `epochExit`
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @param {int} thread - thread slot
+ * @return {void}
+ */
+void epochEnter(EpochDomain *domain, int thread) {
+    EpochRecord *record = &domain->records[thread];
+    unsigned long epoch = atomic_load(&domain->epoch);
+    atomic_store(&record->epoch, epoch);
+    atomic_store(&record->active, TRUE); // seq_cst: published before any shared node is read
+    if (record->lastEpoch != epoch) {
+        // nodes in this bag were retired at least three epochs ago, nobody can still see them
+        epochReclaimBag(domain, &record->limbo[epoch % 3], thread);
+        record->lastEpoch = epoch;
+    }
+}
+
+/**
+ * Leave a critical section
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @param {int} thread - thread slot
+ * @return {void}
+ */
+void epochExit(EpochDomain *domain, int thread) {
+    atomic_store_explicit(&domain->records[thread].active, FALSE, memory_order_release);
+}
+
+/**
+ * Helper function to advance the global epoch if every active thread has observed it
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @return {void}
+ */
+void epochTryAdvance(EpochDomain *domain) {
+    unsigned long epoch = atomic_load(&domain->epoch);
+    int threads = atomic_load(&domain->threads);
+    if (threads > EPOCH_MAX_THREADS) {
+        threads = EPOCH_MAX_THREADS;
+    }
+    for (int i = 0; i < threads; i++) {
+        EpochRecord *record = &domain->records[i];
+        if (atomic_load(&record->active) && atomic_load(&record->epoch) != epoch) {
+            return;
+        }
+    }
+    atomic_compare_exchange_strong(&domain->epoch, &epoch, epoch + 1);
+}
+
+/**
+ * Retire a node unlinked inside the current critical section
+ * @param {EpochDomain *} domain - pointer to an epoch domain
+ * @param {int} thread - thread slot
+ * @param {void *} node - unlinked node
+ * @return {void}
+ */
+void epochRetire(EpochDomain *domain, int thread, void *node) {
+    EpochRecord *record = &domain->records[thread];
+    LimboBag *bag = &record->limbo[atomic_load_explicit(&record->epoch, memory_order_relaxed) % 3];
+    if (bag->count == bag->capacity) {
+        int capacity = bag->capacity ? 2 * bag->capacity : EPOCH_ADVANCE_INTERVAL;
+        void **items = (void **) realloc(bag->items, capacity * sizeof(void *));
+        if (!items) { // can't defer, leak the node rather than free it under a reader
+            return;
+        }
+        bag->items = items;
+        bag->capacity = capacity;
+    }
+    bag->items[bag->count++] = node;
+    if (++record->retiredCount % EPOCH_ADVANCE_INTERVAL == 0) {
+        epochTryAdvance(domain);
+    }
+}
+
+/**
+ * Helper function to free a node of a concurrent set
+ * @param {void *} node - node
+ * @param {void *} context - unused
+ * @param {int} thread - unused
+ * @return {void}
+ */
+void concurrentFreeHelper(void *node, void *context, int thread) {
+    (void) context;
+    (void) thread;
+    free(node);
+}
+
+/**
+ * Initialize a concurrent set
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @return {Status} - execution status
+ */
+Status initializeConcurrentSet(ConcurrentSet *set) {
+    if (set->initialized) { // already exists
+        return ERROR;
+    }
+    atomic_init(&set->head.next, (uintptr_t) NULL);
+    initializeEpochDomain(&set->domain, concurrentFreeHelper, NULL);
+    set->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Destroy a concurrent set, only when no other thread uses it
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @return {Status} - execution status
+ */
+Status destroyConcurrentSet(ConcurrentSet *set) {
+    if (!set->initialized) { // set doesn't exist
+        return ERROR;
+    }
+    ConcurrentNode *node = CONCURRENT_POINTER(atomic_load(&set->head.next));
+    while (node) {
+        ConcurrentNode *next = CONCURRENT_POINTER(atomic_load(&node->next));
+        free(node);
+        node = next;
+    }
+    destroyEpochDomain(&set->domain);
+    set->initialized = FALSE;
+    return OK;
+}
+
+/**
+ * Register the calling thread in a concurrent set
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @return {int} - thread slot to be passed to other operations, ERROR if too many threads
+ */
+int concurrentRegister(ConcurrentSet *set) {
+    return epochRegister(&set->domain);
+}
+
+/**
+ * Helper function to find the first node not less than `e`, unlinking marked nodes on the way
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @param {int} thread - thread slot
+ * @param {ElemType} e - value
+ * @param {_Atomic(uintptr_t) **} prevLink - link pointing to the found node
+ * @return {ConcurrentNode *} - found node, NULL if at the end of set
+ */
+ConcurrentNode *concurrentFind(ConcurrentSet *set, int thread, ElemType e, _Atomic(uintptr_t) **prevLink) {
+    retry:;
+    _Atomic(uintptr_t) *prev = &set->head.next;
+    ConcurrentNode *curr = CONCURRENT_POINTER(atomic_load(prev));
+    while (curr) {
+        uintptr_t next = atomic_load(&curr->next);
+        if (CONCURRENT_MARKED(next)) { // `curr` is logically deleted, unlink it
+            uintptr_t expected = (uintptr_t) curr;
+            if (!atomic_compare_exchange_strong(prev, &expected, CONCURRENT_UNMARK(next))) {
+                goto retry; // `prev` changed or got deleted itself
+            }
+            epochRetire(&set->domain, thread, curr);
+            curr = CONCURRENT_POINTER(next);
+            continue;
+        }
+        if (curr->value >= e) {
+            break;
+        }
+        prev = &curr->next;
+        curr = CONCURRENT_POINTER(next);
+    }
+    *prevLink = prev;
+    return curr;
+}
+
+/**
+ * Insert a value into a concurrent set
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @param {int} thread - thread slot
+ * @param {ElemType} e - value
+ * @return {Boolean} - FALSE if the value already exists or out of memory
+ */
+Boolean concurrentInsert(ConcurrentSet *set, int thread, ElemType e) {
+    ConcurrentNode *newNode = (ConcurrentNode *) malloc(sizeof(ConcurrentNode));
+    if (!newNode) {
+        return FALSE;
+    }
+    newNode->value = e;
+    epochEnter(&set->domain, thread);
+    Boolean inserted;
+    while (TRUE) {
+        _Atomic(uintptr_t) *prev;
+        ConcurrentNode *curr = concurrentFind(set, thread, e, &prev);
+        if (curr && curr->value == e) {
+            inserted = FALSE;
+            break;
+        }
+        atomic_store_explicit(&newNode->next, (uintptr_t) curr, memory_order_relaxed);
+        uintptr_t expected = (uintptr_t) curr;
+        if (atomic_compare_exchange_strong(prev, &expected, (uintptr_t) newNode)) {
+            inserted = TRUE;
+            break;
+        }
+    }
+    epochExit(&set->domain, thread);
+    if (!inserted) {
+        free(newNode); // never published
+    }
+    return inserted;
+}
+
+/**
+ * Remove a value from a concurrent set
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @param {int} thread - thread slot
+ * @param {ElemType} e - value
+ * @return {Boolean} - FALSE if the value doesn't exist
+ */
+Boolean concurrentRemove(ConcurrentSet *set, int thread, ElemType e) {
+    epochEnter(&set->domain, thread);
+    Boolean removed;
+    while (TRUE) {
+        _Atomic(uintptr_t) *prev;
+        ConcurrentNode *curr = concurrentFind(set, thread, e, &prev);
+        if (!curr || curr->value != e) {
+            removed = FALSE;
+            break;
+        }
+        uintptr_t next = atomic_load(&curr->next);
+        if (CONCURRENT_MARKED(next)) { // another thread is deleting it, let `concurrentFind` clean up
+            continue;
+        }
+        // logical deletion: mark the link of `curr`
+        if (!atomic_compare_exchange_strong(&curr->next, &next, next | 1)) {
+            continue;
+        }
+        // physical deletion, if it fails the next traversal will do it
+        uintptr_t expected = (uintptr_t) curr;
+        if (atomic_compare_exchange_strong(prev, &expected, next)) {
+            epochRetire(&set->domain, thread, curr);
+        } else {
+            concurrentFind(set, thread, e, &prev);
+        }
+        removed = TRUE;
+        break;
+    }
+    epochExit(&set->domain, thread);
+    return removed;
+}
+
+/**
+ * Does a concurrent set contain a value (wait-free)
+ * @param {ConcurrentSet *} set - pointer to a concurrent set
+ * @param {int} thread - thread slot
+ * @param {ElemType} e - value
+ * @return {Boolean}
+ */
+Boolean concurrentContains(ConcurrentSet *set, int thread, ElemType e) {
+    epochEnter(&set->domain, thread);
+    ConcurrentNode *curr = CONCURRENT_POINTER(atomic_load(&set->head.next));
+    while (curr && curr->value < e) {
+        curr = CONCURRENT_POINTER(atomic_load(&curr->next));
+    }
+    Boolean found = curr && curr->value == e && !CONCURRENT_MARKED(atomic_load(&curr->next));
+    epochExit(&set->domain, thread);
+    return found;
+}
+
+/**
+ * Get current time in seconds
+ * @param {void}
+ * @return {double}
+ */
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Helper function to generate pseudo random numbers (xorshift)
+ * @param {uint64_t *} state - random state, must not be 0
+ * @return {uint32_t}
+ */
+uint32_t randomHelper(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return (uint32_t) (x >> 32);
+}
+
+/**
+ * Helper function run by each thread of `concurrentBenchmark`
+ * @param {void *} argument - pointer to `ConcurrentWorker`
+ * @return {void *}
+ */
+void *concurrentWorkerHelper(void *argument) {
+    ConcurrentWorker *worker = (ConcurrentWorker *) argument;
+    ConcurrentSet *set = worker->set;
+    int thread = concurrentRegister(set);
+    uint64_t state = worker->seed;
+    int delta = 0; // successful inserts minus successful removes
+    for (int i = 0; i < worker->operations; i++) {
+        uint32_t r = randomHelper(&state);
+        ElemType e = (ElemType) (r % (uint32_t) worker->range);
+        switch ((r >> 24) % 10) {
+            case 0: // 20% insert
+            case 1:
+                delta += concurrentInsert(set, thread, e);
+                break;
+            case 2: // 20% remove
+            case 3:
+                delta -= concurrentRemove(set, thread, e);
+                break;
+            default: // 60% lookup
+                concurrentContains(set, thread, e);
+                break;
+        }
+    }
+    worker->delta = delta;
+    return NULL;
+}
+
+/**
+ * Stress and throughput benchmark of concurrent set with 1, 2, 4, ... threads
+ * @param {int} maxThreads - max number of threads
+ * @param {int} operations - operations per thread
+ * @param {int} range - values are drawn from [0, range)
+ * @return {Status} - execution status, ERROR if the set is found inconsistent
+ */
+Status concurrentBenchmark(int maxThreads, int operations, int range) {
+    if (maxThreads < 1 || maxThreads >= EPOCH_MAX_THREADS || operations < 1 || range < 1) {
+        return ERROR;
+    }
+    ConcurrentSet *set = (ConcurrentSet *) malloc(sizeof(ConcurrentSet));
+    pthread_t *threads = (pthread_t *) malloc(maxThreads * sizeof(pthread_t));
+    ConcurrentWorker *workers = (ConcurrentWorker *) malloc(maxThreads * sizeof(ConcurrentWorker));
+    if (!set || !threads || !workers) {
+        free(set);
+        free(threads);
+        free(workers);
+        return OVERFLOW;
+    }
+    Status status = OK;
+    printf("threads    Mops/s    size\n");
+    for (int n = 1; status == OK; n *= 2) {
+        if (n > maxThreads) {
+            n = maxThreads;
+        }
+        set->initialized = FALSE;
+        initializeConcurrentSet(set);
+        // prefill half of the range so that inserts and removes both succeed
+        int prefill = concurrentRegister(set);
+        int size = 0;
+        for (int e = 0; e < range; e += 2) {
+            size += concurrentInsert(set, prefill, e);
+        }
+        double start = now();
+        int started = 0;
+        for (int i = 0; i < n; i++) {
+            workers[i].set = set;
+            workers[i].operations = operations;
+            workers[i].range = range;
+            workers[i].seed = 0x9E3779B97F4A7C15ull * (i + 1);
+            workers[i].delta = 0;
+            if (pthread_create(&threads[i], NULL, concurrentWorkerHelper, &workers[i]) != 0) {
+                break;
+            }
+            started++;
+        }
+        for (int i = 0; i < started; i++) { // only threads that were created
+            pthread_join(threads[i], NULL);
+            size += workers[i].delta;
+        }
+        double elapsed = now() - start;
+        if (started < n) { // out of threads
+            printf("%7d failed to create threads\n", n);
+            destroyConcurrentSet(set);
+            status = OVERFLOW;
+            break;
+        }
+
+        // check the set is strictly increasing and matches the successful operations
+        int count = 0;
+        ConcurrentNode *node = CONCURRENT_POINTER(atomic_load(&set->head.next));
+        for (ConcurrentNode *prev = NULL; node; prev = node, node = CONCURRENT_POINTER(atomic_load(&node->next))) {
+            if (CONCURRENT_MARKED(atomic_load(&node->next)) || (prev && prev->value >= node->value)) {
+                status = ERROR;
+            }
+            count++;
+        }
+        if (count != size) {
+            status = ERROR;
+        }
+        printf("%7d %9.2f %7d%s\n", n, (double) n * operations / elapsed / 1e6, count, status == OK ? "" : "  INCONSISTENT!");
+        destroyConcurrentSet(set);
+        if (n == maxThreads) {
+            break;
+        }
+    }
+    free(workers);
+    free(threads);
+    free(set);
+    return status;
+}
+
+/**
+ * Helper function to take a node from the pool of a thread, or allocate one
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @param {int} thread - thread slot
+ * @return {QueueNode *}
+ */
+QueueNode *queueAllocate(ConcurrentQueue *queue, int thread) {
+    QueuePool *pool = &queue->pools[thread];
+    QueueNode *node = pool->free;
+    if (node) {
+        pool->free = atomic_load_explicit(&node->next, memory_order_relaxed);
+        pool->count--;
+        return node;
+    }
+    return (QueueNode *) malloc(sizeof(QueueNode));
+}
+
+/**
+ * Helper function to recycle a reclaimed node into the pool of the reclaiming thread
+ * @param {void *} node - node
+ * @param {void *} context - pointer to the concurrent queue
+ * @param {int} thread - thread slot
+ * @return {void}
+ */
+void queueRecycleHelper(void *node, void *context, int thread) {
+    QueuePool *pool = &((ConcurrentQueue *) context)->pools[thread];
+    if (pool->count >= QUEUE_POOL_MAX) { // keep pools of pure consumers bounded
+        free(node);
+        return;
+    }
+    atomic_store_explicit(&((QueueNode *) node)->next, pool->free, memory_order_relaxed);
+    pool->free = (QueueNode *) node;
+    pool->count++;
+}
+
+/**
+ * Initialize a concurrent queue
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @return {Status} - execution status
+ */
+Status initializeConcurrentQueue(ConcurrentQueue *queue) {
+    if (queue->initialized) { // already exists
+        return ERROR;
+    }
+    QueueNode *dummy = (QueueNode *) malloc(sizeof(QueueNode));
+    if (!dummy) {
+        return OVERFLOW;
+    }
+    atomic_init(&dummy->next, NULL);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    initializeEpochDomain(&queue->domain, queueRecycleHelper, queue);
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        queue->pools[i].free = NULL;
+        queue->pools[i].count = 0;
+    }
+    queue->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Destroy a concurrent queue, only when no other thread uses it
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @return {Status} - execution status
+ */
+Status destroyConcurrentQueue(ConcurrentQueue *queue) {
+    if (!queue->initialized) { // queue doesn't exist
+        return ERROR;
+    }
+    QueueNode *node = atomic_load(&queue->head);
+    while (node) {
+        QueueNode *next = atomic_load(&node->next);
+        free(node);
+        node = next;
+    }
+    destroyEpochDomain(&queue->domain); // moves retired nodes into pools
+    for (int i = 0; i < EPOCH_MAX_THREADS; i++) {
+        node = queue->pools[i].free;
+        while (node) {
+            QueueNode *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+            free(node);
+            node = next;
+        }
+        queue->pools[i].free = NULL;
+        queue->pools[i].count = 0;
+    }
+    queue->initialized = FALSE;
+    return OK;
+}
+
+/**
+ * Register the calling thread in a concurrent queue
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @return {int} - thread slot to be passed to other operations, ERROR if too many threads
+ */
+int queueRegister(ConcurrentQueue *queue) {
+    return epochRegister(&queue->domain);
+}
+
+/**
+ * Enqueue a batch of values with a single successful CAS on the last link
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @param {int} thread - thread slot
+ * @param {ElemType *} values - values to be enqueued, in order
+ * @param {int} count - number of values
+ * @return {Status} - execution status
+ */
+Status enqueueBatch(ConcurrentQueue *queue, int thread, ElemType *values, int count) {
+    if (count <= 0) {
+        return count == 0 ? OK : ERROR;
+    }
+    // link the batch privately first
+    QueueNode *first = NULL, *last = NULL;
+    for (int i = count - 1; i >= 0; i--) {
+        QueueNode *node = queueAllocate(queue, thread);
+        if (!node) {
+            while (first) { // give back what was taken
+                QueueNode *next = atomic_load_explicit(&first->next, memory_order_relaxed);
+                queueRecycleHelper(first, queue, thread);
+                first = next;
+            }
+            return OVERFLOW;
+        }
+        node->value = values[i];
+        atomic_store_explicit(&node->next, first, memory_order_relaxed);
+        if (!last) {
+            last = node;
+        }
+        first = node;
+    }
+
+    epochEnter(&queue->domain, thread);
+    while (TRUE) {
+        QueueNode *tail = atomic_load(&queue->tail);
+        QueueNode *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+        if (next) { // tail is lagging, help to swing it
+            atomic_compare_exchange_strong(&queue->tail, &tail, next);
+            continue;
+        }
+        QueueNode *expected = NULL;
+        if (atomic_compare_exchange_strong(&tail->next, &expected, first)) {
+            // may fail if another thread helped, which walks the batch one node at a time
+            atomic_compare_exchange_strong(&queue->tail, &tail, last);
+            break;
+        }
+    }
+    epochExit(&queue->domain, thread);
+    return OK;
+}
+
+/**
+ * Enqueue a value
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @param {int} thread - thread slot
+ * @param {ElemType} e - value
+ * @return {Status} - execution status
+ */
+Status enqueue(ConcurrentQueue *queue, int thread, ElemType e) {
+    return enqueueBatch(queue, thread, &e, 1);
+}
+
+/**
+ * Dequeue up to `count` values with a single successful CAS on head
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @param {int} thread - thread slot
+ * @param {ElemType *} values - buffer of at least `count` values
+ * @param {int} count - max number of values
+ * @return {int} - number of values dequeued, 0 if the queue is empty
+ */
+int dequeueBatch(ConcurrentQueue *queue, int thread, ElemType *values, int count) {
+    if (count <= 0) {
+        return 0;
+    }
+    int taken = 0;
+    epochEnter(&queue->domain, thread);
+    while (TRUE) {
+        QueueNode *head = atomic_load(&queue->head);
+        QueueNode *tail = atomic_load(&queue->tail);
+        QueueNode *next = atomic_load(&head->next);
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+        if (head == tail) {
+            if (!next) { // empty
+                break;
+            }
+            atomic_compare_exchange_strong(&queue->tail, &tail, next); // help the lagging tail
+            continue;
+        }
+        // walk at most `count` nodes, never past tail, so head never overtakes it
+        QueueNode *node = head;
+        int n = 0;
+        while (n < count && node != tail && (next = atomic_load(&node->next))) {
+            values[n++] = next->value; // read before the CAS, the node may be recycled after it
+            node = next;
+        }
+        if (atomic_compare_exchange_strong(&queue->head, &head, node)) {
+            // the old head and all but the last node walked become garbage, `node` is the new dummy
+            for (QueueNode *garbage = head; garbage != node;) {
+                QueueNode *following = atomic_load(&garbage->next);
+                epochRetire(&queue->domain, thread, garbage);
+                garbage = following;
+            }
+            taken = n;
+            break;
+        }
+    }
+    epochExit(&queue->domain, thread);
+    return taken;
+}
+
+/**
+ * Dequeue a value
+ * @param {ConcurrentQueue *} queue - pointer to a concurrent queue
+ * @param {int} thread - thread slot
+ * @param {ElemType *} e - the value dequeued
+ * @return {Status} - execution status, ERROR if the queue is empty
+ */
+Status dequeue(ConcurrentQueue *queue, int thread, ElemType *e) {
+    return dequeueBatch(queue, thread, e, 1) ? OK : ERROR;
+}
+
+/**
+ * Helper function run by each thread of `queueConcurrencyBenchmark`
+ * @param {void *} argument - pointer to `QueueWorker`
+ * @return {void *}
+ */
+void *queueWorkerHelper(void *argument) {
+    QueueWorker *worker = (QueueWorker *) argument;
+    int batch = worker->batch;
+    ElemType values[QUEUE_BATCH_MAX];
+    long long produced = 0, consumed = 0;
+    int thread = worker->queue ? queueRegister(worker->queue) : 0;
+    for (int i = 0; i < worker->operations; i += batch) {
+        for (int j = 0; j < batch; j++) {
+            values[j] = worker->base + i + j;
+            produced += values[j];
+        }
+        int taken = 0;
+        if (worker->queue) {
+            if (batch == 1) {
+                enqueue(worker->queue, thread, values[0]);
+                taken = dequeue(worker->queue, thread, values) == OK;
+            } else {
+                enqueueBatch(worker->queue, thread, values, batch);
+                taken = dequeueBatch(worker->queue, thread, values, batch);
+            }
+        } else { // mutex-protected list
+            for (int j = 0; j < batch; j++) {
+                pthread_mutex_lock(worker->mutex);
+                pushBack(worker->list, values[j]);
+                pthread_mutex_unlock(worker->mutex);
+            }
+            for (int j = 0; j < batch; j++) {
+                pthread_mutex_lock(worker->mutex);
+                taken += popFront(worker->list, &values[taken]) == OK;
+                pthread_mutex_unlock(worker->mutex);
+            }
+        }
+        for (int j = 0; j < taken; j++) {
+            consumed += values[j];
+        }
+    }
+    worker->produced = produced;
+    worker->consumed = consumed;
+    return NULL;
+}
+
+/**
+ * Benchmark of the lock-free queue against a mutex-protected list with 2, 4, ... threads,
+ * each thread enqueues and then dequeues `batch` values at a time
+ * @param {int} maxThreads - max number of threads
+ * @param {int} operations - values enqueued per thread
+ * @param {int} batch - batch size of the lock-free queue
+ * @return {Status} - execution status, ERROR if values are lost or duplicated
+ */
+Status queueConcurrencyBenchmark(int maxThreads, int operations, int batch) {
+    if (maxThreads < 2 || maxThreads >= EPOCH_MAX_THREADS || operations < 1 || batch < 1 || batch > QUEUE_BATCH_MAX) {
+        return ERROR;
+    }
+    ConcurrentQueue *queue = (ConcurrentQueue *) malloc(sizeof(ConcurrentQueue));
+    pthread_t *threads = (pthread_t *) malloc(maxThreads * sizeof(pthread_t));
+    QueueWorker *workers = (QueueWorker *) malloc(maxThreads * sizeof(QueueWorker));
+    if (!queue || !threads || !workers) {
+        free(queue);
+        free(threads);
+        free(workers);
+        return OVERFLOW;
+    }
+    pthread_mutex_t mutex;
+    pthread_mutex_init(&mutex, NULL);
+    Status status = OK;
+    printf("threads  mutex Mops/s  lock-free Mops/s  batch-%d Mops/s\n", batch);
+    for (int n = 2; status == OK; n *= 2) {
+        if (n > maxThreads) {
+            n = maxThreads;
+        }
+        double throughput[3];
+        for (int mode = 0; mode < 3; mode++) { // mutex, lock-free, lock-free batched
+            LinkList list;
+            list.initialized = FALSE;
+            initializeList(&list);
+            queue->initialized = FALSE;
+            initializeConcurrentQueue(queue);
+            double start = now();
+            int started = 0;
+            for (int i = 0; i < n; i++) {
+                workers[i].queue = mode ? queue : NULL;
+                workers[i].list = &list;
+                workers[i].mutex = &mutex;
+                workers[i].operations = operations;
+                workers[i].batch = mode == 2 ? batch : 1;
+                workers[i].base = (ElemType) i * operations;
+                if (pthread_create(&threads[i], NULL, queueWorkerHelper, &workers[i]) != 0) {
+                    break;
+                }
+                started++;
+            }
+            if (started < n) { // out of threads
+                status = OVERFLOW;
+            }
+            long long produced = 0, consumed = 0;
+            for (int i = 0; i < started; i++) { // only threads that were created
+                pthread_join(threads[i], NULL);
+                produced += workers[i].produced;
+                consumed += workers[i].consumed;
+            }
+            throughput[mode] = 2.0 * n * operations / (now() - start) / 1e6;
+            // whatever a thread couldn't dequeue is still queued
+            ElemType e;
+            int thread = queueRegister(queue);
+            while (dequeue(queue, thread, &e) == OK) {
+                consumed += e;
+            }
+            while (popFront(&list, &e) == OK) {
+                consumed += e;
+            }
+            if (produced != consumed) {
+                status = ERROR;
+            }
+            destroyConcurrentQueue(queue);
+            destroyList(&list);
+            if (status == OVERFLOW) {
+                break;
+            }
+        }
+        if (status == OVERFLOW) {
+            printf("%7d failed to create threads\n", n);
+            break;
+        }
+        printf("%7d %12.2f %17.2f %15.2f%s\n", n, throughput[0], throughput[1], throughput[2],
+               status == OK ? "" : "  INCONSISTENT!");
+        if (n == maxThreads) {
+            break;
+        }
+    }
+    pthread_mutex_destroy(&mutex);
+    free(workers);
+    free(threads);
+    free(queue);
+    return status;
+}
+
+/**
+ * Helper function to sum values of visited nodes
+ * @param {LinkNode *} node - node
+ * @return {void}
+ */
+void sumHelper(LinkNode *node) {
+    traverseSum += node->value;
+}
+
+/**
+ * Benchmark of traversal on a list whose nodes are linked in random allocation order
+ * @param {int} length - length of the list
+ * @return {Status} - execution status
+ */
+Status prefetchBenchmark(int length) {
+    if (length < 1) {
+        return ERROR;
+    }
+    LinkNode **nodes = (LinkNode **) malloc(length * sizeof(LinkNode *));
+    if (!nodes) {
+        return OVERFLOW;
+    }
+    for (int i = 0; i < length; i++) {
+        nodes[i] = (LinkNode *) malloc(sizeof(LinkNode));
+        nodes[i]->value = i;
+        nodes[i]->dead = FALSE;
+    }
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (int i = length - 1; i > 0; i--) { // shuffle, then link in shuffled order
+        int j = (int) (randomHelper(&state) % (uint32_t) (i + 1));
+        LinkNode *node = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = node;
+    }
+    LinkList list;
+    list.initialized = FALSE;
+    initializeList(&list);
+    for (int i = 0; i < length; i++) {
+        nodes[i]->next = i + 1 < length ? nodes[i + 1] : NULL;
+    }
+    list.head = nodes[0];
+    list.tail = nodes[length - 1];
+    list.length = length;
+    free(nodes);
+
+    long long expected = (long long) length * (length - 1) / 2;
+    double start = now();
+    traverseSum = 0;
+    listTraverse(&list, sumHelper);
+    double plain = now() - start;
+    Status status = traverseSum == expected ? OK : ERROR;
+
+    start = now();
+    listBuildJumpTable(&list);
+    double build = now() - start;
+    start = now();
+    traverseSum = 0;
+    listTraversePrefetch(&list, sumHelper);
+    double prefetched = now() - start;
+    status = traverseSum == expected ? status : ERROR;
+
+    start = now();
+    listCompact(&list);
+    double compaction = now() - start;
+    start = now();
+    traverseSum = 0;
+    listTraverse(&list, sumHelper);
+    double compacted = now() - start;
+    status = traverseSum == expected ? status : ERROR;
+
+    printf("traversal of %d randomly linked nodes:\n", length);
+    printf("  plain              %8.2f ms\n", plain * 1e3);
+    printf("  prefetch           %8.2f ms (%.2fx, table built in %.2f ms)\n", prefetched * 1e3, plain / prefetched, build * 1e3);
+    printf("  after listCompact  %8.2f ms (%.2fx, compacted in %.2f ms)\n", compacted * 1e3, plain / compacted, compaction * 1e3);
+    destroyList(&list);
+    return status;
+}
+
+/**
+ * Benchmark of a list used as a FIFO queue through `pushBack` and `popFront`
+ * @param {int} operations - number of elements passed through the queue
+ * @return {Status} - execution status
+ */
+Status queueBenchmark(int operations) {
+    if (operations < 1) {
+        return ERROR;
+    }
+    LinkList queue;
+    queue.initialized = FALSE;
+    initializeList(&queue);
+    listSetCapacity(&queue, QUEUE_BENCHMARK_CAPACITY);
+    Status status = OK;
+    long long sum = 0;
+    int produced = 0;
+    double start = now();
+    while (produced < operations || queue.length) {
+        // producer fills until backpressure, consumer drains half
+        while (produced < operations && pushBack(&queue, produced) == OK) {
+            produced++;
+        }
+        for (int i = queue.length == QUEUE_BENCHMARK_CAPACITY ? QUEUE_BENCHMARK_CAPACITY / 2 : queue.length; i > 0; i--) {
+            ElemType e = 0;
+            popFront(&queue, &e);
+            sum += e;
+        }
+    }
+    double elapsed = now() - start;
+    if (sum != (long long) operations * (operations - 1) / 2) {
+        status = ERROR;
+    }
+    printf("%d pushes and pops in %.2f ms, %.2f Mops/s\n", operations, elapsed * 1e3, 2.0 * operations / elapsed / 1e6);
+    destroyList(&queue);
+    return status;
+}
+
+/**
+ * Benchmark of self-organizing modes on lookups following a Zipf distribution (s = 1)
+ * @param {int} length - length of list
+ * @param {int} lookups - number of lookups per mode
+ * @return {Status} - execution status
+ */
+Status organizeBenchmark(int length, int lookups) {
+    if (length < 1 || lookups < 1) {
+        return ERROR;
+    }
+    ElemType *values = (ElemType *) malloc(length * sizeof(ElemType));
+    double *cdf = (double *) malloc(length * sizeof(double));
+    ElemType *queries = (ElemType *) malloc(lookups * sizeof(ElemType));
+    if (!values || !cdf || !queries) {
+        free(values);
+        free(cdf);
+        free(queries);
+        return OVERFLOW;
+    }
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < length; i++) {
+        values[i] = i;
+    }
+    for (int i = length - 1; i > 0; i--) { // hot values end up anywhere in the list
+        int j = (int) (randomHelper(&state) % (uint32_t) (i + 1));
+        ElemType value = values[i];
+        values[i] = values[j];
+        values[j] = value;
+    }
+    double total = 0;
+    for (int i = 0; i < length; i++) {
+        total += 1.0 / (i + 1);
+        cdf[i] = total;
+    }
+    for (int i = 0; i < lookups; i++) { // the value of rank r is r
+        double u = randomHelper(&state) / 4294967296.0 * total;
+        int low = 0, high = length - 1;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (cdf[middle] < u) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        queries[i] = low;
+    }
+
+    const char *names[] = {"none", "move-to-front", "transpose"};
+    Status status = OK;
+    printf("%d Zipf lookups on a list of %d:\n", lookups, length);
+    for (int mode = ORGANIZE_NONE; mode <= ORGANIZE_TRANSPOSE; mode++) {
+        LinkList list;
+        list.initialized = FALSE;
+        initializeList(&list);
+        for (int i = 0; i < length; i++) {
+            listInsert(&list, i + 1, values[i]);
+        }
+        listSetOrganize(&list, mode);
+        double start = now();
+        for (int i = 0; i < lookups; i++) {
+            if (!locateElem(&list, queries[i], equal)) {
+                status = ERROR;
+            }
+        }
+        double elapsed = now() - start;
+        printf("  %-14s average probe depth %10.2f, %8.2f ms\n", names[mode], listProbeDepth(&list), elapsed * 1e3);
+        destroyList(&list);
+    }
+    free(values);
+    free(cdf);
+    free(queries);
+    return status;
+}
+
+/**
+ * Benchmark of deleting scattered elements eagerly or lazily, followed by a full scan
+ * @param {int} length - length of list
+ * @param {int} count - number of elements to be deleted
+ * @return {Status} - execution status
+ */
+Status tombstoneBenchmark(int length, int count) {
+    if (length < 1 || count < 0 || count > length) {
+        return ERROR;
+    }
+    ElemType *victims = (ElemType *) malloc(length * sizeof(ElemType));
+    LinkNode **handles = (LinkNode **) malloc(length * sizeof(LinkNode *));
+    if (!victims || !handles) {
+        free(victims);
+        free(handles);
+        return OVERFLOW;
+    }
+    for (int i = 0; i < length; i++) {
+        victims[i] = i;
+    }
+    uint64_t state = 0xD1B54A32D192ED03ull;
+    for (int i = 0; i < count; i++) { // the first `count` values after a partial shuffle
+        int j = i + (int) (randomHelper(&state) % (uint32_t) (length - i));
+        ElemType value = victims[i];
+        victims[i] = victims[j];
+        victims[j] = value;
+    }
+    long long expected = (long long) length * (length - 1) / 2;
+    for (int i = 0; i < count; i++) {
+        expected -= victims[i];
+    }
+
+    Status status = OK;
+    double elapsed[2];
+    for (int lazy = 0; lazy < 2; lazy++) {
+        LinkList list;
+        list.initialized = FALSE;
+        initializeList(&list);
+        listBuildIndex(&list); // lets `listMarkDead` check membership in O(1)
+        int k = 0;
+        for (int i = 0; i < length; i++) {
+            listInsert(&list, i + 1, i);
+            handles[i] = list.tail; // value `i` lives in `handles[i]`
+        }
+        double start = now();
+        for (int i = 0; i < count; i++) {
+            if (lazy) {
+                k += listMarkDead(&list, handles[victims[i]]) == OK;
+            } else {
+                k += listDeleteValue(&list, victims[i]) == OK;
+            }
+        }
+        traverseSum = 0;
+        listTraverse(&list, sumHelper);
+        elapsed[lazy] = now() - start;
+        if (k != count || traverseSum != expected || list.length != length - count) {
+            status = ERROR;
+        }
+        destroyList(&list);
+    }
+    printf("deleting %d of %d elements, then a full scan:\n", count, length);
+    printf("  listDeleteValue  %10.2f ms\n", elapsed[0] * 1e3);
+    printf("  listMarkDead     %10.2f ms (%.2fx)\n", elapsed[1] * 1e3, elapsed[0] / elapsed[1]);
+    free(victims);
+    free(handles);
+    return status;
+}
+
+/**
+ * Benchmark of building and clearing a list with nodes allocated one by one or from an arena
+ * @param {int} length - length of list
+ * @return {Status} - execution status
+ */
+Status arenaBenchmark(int length) {
+    if (length < 1) {
         return ERROR;
-    } else {
-        ElemType element;
-        int i = 1, length;
-        /* fscanf: read as ascii */
-        fscanf(fp, "%d\n\n", &length);
-        if (length < 0) {
-            printf("Length is illegal!\n");
-            return ERROR;
+    }
+    Status status = OK;
+    double build[2], clear[2];
+    for (int arena = 0; arena < 2; arena++) {
+        LinkList list;
+        list.initialized = FALSE;
+        initializeList(&list);
+        if (arena && listUseArena(&list) != OK) {
+            return OVERFLOW;
         }
-        printf("Loading list of length %d...\n", length);
-
-        while (fscanf(fp, "%d\n", &element) != EOF) { // while element value exists
-            listInsert(list, i, element); // insert into the end of list
-            i++;
+        double start = now();
+        for (int i = 0; i < length; i++) {
+            if (listInsert(&list, i + 1, i) != OK) {
+                status = ERROR;
+            }
         }
-
-        fclose(fp);
-        return OK;
+        build[arena] = now() - start;
+        start = now();
+        clearList(&list);
+        clear[arena] = now() - start;
+        if (list.length || list.head) {
+            status = ERROR;
+        }
+        destroyList(&list);
     }
+    printf("building and clearing a list of %d:\n", length);
+    printf("  malloc  build %8.2f ms, clear %8.2f ms\n", build[0] * 1e3, clear[0] * 1e3);
+    printf("  arena   build %8.2f ms, clear %8.2f ms\n", build[1] * 1e3, clear[1] * 1e3);
+    return status;
 }
 
 /**
- * Save data to a file
- * @param {LinkList *} list - list
+ * Helper function to compare values for `qsort`
+ * @param {const void *} x - pointer to a value
+ * @param {const void *} y - pointer to a value
+ * @return {int}
+ */
+int valueCompareHelper(const void *x, const void *y) {
+    ElemType a = *(const ElemType *) x;
+    ElemType b = *(const ElemType *) y;
+    return a < b ? -1 : a > b;
+}
+
+/**
+ * Benchmark of converting between arrays and lists, and of merging sorted runs
+ * @param {int} length - length of list
+ * @param {int} runs - number of sorted runs to be merged
  * @return {Status} - execution status
  */
-Status saveData(LinkList *list) {
-    if (!list->initialized) { // list doesn't exist
+Status arrayBenchmark(int length, int runs) {
+    if (length < 1 || runs < 1 || runs > length) {
         return ERROR;
     }
+    ElemType *values = (ElemType *) malloc(length * sizeof(ElemType));
+    ElemType *out = (ElemType *) malloc(length * sizeof(ElemType));
+    LinkList *lists = (LinkList *) malloc(runs * sizeof(LinkList));
+    LinkList **pointers = (LinkList **) malloc(runs * sizeof(LinkList *));
+    if (!values || !out || !lists || !pointers) {
+        free(values);
+        free(out);
+        free(lists);
+        free(pointers);
+        return OVERFLOW;
+    }
+    uint64_t state = 0xA0761D6478BD642Full;
+    for (int i = 0; i < length; i++) {
+        values[i] = (ElemType) (randomHelper(&state) >> 1);
+    }
+    Status status = OK;
+    LinkList list;
+    list.initialized = FALSE;
+    initializeList(&list);
+    double start = now();
+    for (int i = 0; i < length; i++) {
+        listInsert(&list, i + 1, values[i]);
+    }
+    double inserted = now() - start;
+    destroyList(&list);
 
-    FILE *fp = fopen("data.txt", "w");
-    if (fp == NULL) { // file doesn't exist
-        fp = fopen("data.txt", "wb"); // create it first
+    start = now();
+    status = listFromArray(&list, values, length);
+    double built = now() - start;
+    start = now();
+    listToArray(&list, out);
+    double copied = now() - start;
+    if (status != OK || memcmp(values, out, length * sizeof(ElemType))) {
+        status = ERROR;
     }
-    /* fprintf: write in ascii */
-    fprintf(fp, "%d\n\n", list->length);
-    LinkNode *node = list->head;
-    while (node) {
-        fprintf(fp, "%d\n", node->value);
-        node = node->next;
+    start = now();
+    memcpy(out, values, length * sizeof(ElemType));
+    double bandwidth = now() - start;
+    destroyList(&list);
+
+    // `runs` sorted runs of nearly equal length
+    for (int i = 0, begin = 0; i < runs; i++) {
+        int end = (int) ((long long) length * (i + 1) / runs);
+        qsort(values + begin, end - begin, sizeof(ElemType), valueCompareHelper);
+        lists[i].initialized = FALSE;
+        listFromArray(&lists[i], values + begin, end - begin);
+        pointers[i] = &lists[i];
+        begin = end;
     }
-    fclose(fp);
-    return OK;
+    start = now();
+    status = listMergeSorted(&list, pointers, runs) == OK ? status : ERROR;
+    double merged = now() - start;
+    listToArray(&list, out);
+    for (int i = 1; i < length; i++) {
+        if (out[i - 1] > out[i]) {
+            status = ERROR;
+        }
+    }
+    destroyList(&list);
+    for (int i = 0; i < runs; i++) {
+        destroyList(&lists[i]);
+    }
+
+    printf("converting %d elements:\n", length);
+    printf("  listInsert one by one  %8.2f ms\n", inserted * 1e3);
+    printf("  listFromArray          %8.2f ms\n", built * 1e3);
+    printf("  listToArray            %8.2f ms\n", copied * 1e3);
+    printf("  memcpy                 %8.2f ms\n", bandwidth * 1e3);
+    printf("  listMergeSorted of %d runs %8.2f ms\n", runs, merged * 1e3);
+    free(values);
+    free(out);
+    free(lists);
+    free(pointers);
+    return status;
 }
 
 /**
@@ -425,14 +4756,35 @@ void showMenu() {
     printf("    	  6. getElem         13. selectList\n");
     printf("    	  7. locateElem      14. saveData\n");
     printf("    	                     15. loadData\n");
+    printf("    	  16. saveCompactData  17. loadCompactData\n");
+    printf("    	  18. concurrentBenchmark 19. listSort\n");
+    printf("    	  20. listConcat       21. listSplice\n");
+    printf("    	  22. listSplitAt      23. listBuildIndex\n");
+    printf("    	  24. listDropIndex    25. listDeleteValue\n");
+    printf("    	  26. saveVersion      27. restoreVersion\n");
+    printf("    	  28. listCompact      29. prefetchBenchmark\n");
+    printf("    	  30. saveBinaryData   31. loadBinaryData\n");
+    printf("    	  32. pushFront        33. pushBack\n");
+    printf("    	  34. popFront         35. popBack\n");
+    printf("    	  36. peekFront        37. peekBack\n");
+    printf("    	  38. listSetCapacity  39. queueBenchmark\n");
+    printf("    	  40. queueConcurrencyBenchmark\n");
+    printf("    	  41. listSetOrganize  42. organizeBenchmark\n");
+    printf("    	  43. listBuildFilter  44. listDropFilter\n");
+    printf("    	  45. listMarkDead     46. listPurge\n");
+    printf("    	  47. tombstoneBenchmark 48. listUseArena\n");
+    printf("    	  49. arenaBenchmark   50. listMergeSorted\n");
+    printf("    	  51. arrayBenchmark\n");
     printf("    	  0. exit\n");
     printf("------------------------------------------------------\n");
 }
 
 int main() {
     LinkList *listArray = (LinkList *) malloc(TOTAL_LISTS * sizeof(LinkList)); // array of lists
+    PersistentList *versionArray = (PersistentList *) malloc(TOTAL_LISTS * sizeof(PersistentList)); // array of versions
     for (int i = 0; i < TOTAL_LISTS; i++) { // reset initialization status to false
         listArray[i].initialized = FALSE;
+        versionArray[i].initialized = FALSE;
     }
     int currentListIndex = 0; // current index
     LinkList *currentList = &listArray[currentListIndex]; // pointer to current list
@@ -444,7 +4796,7 @@ int main() {
         Status status;
         showMenu();
         printf("Current list: L%d\n", currentListIndex);
-        printf("Please input your option[0-15]:\n");
+        printf("Please input your option[0-51]:\n");
         int isValid = scanf("%d", &option);
         if (!isValid) {
             printf("You entered an invalid value!\n");
@@ -614,6 +4966,417 @@ int main() {
                     printf(status == OK ? "Loaded successfully!\n" : "Failed to load!\n");
                     getchar();
                     break;
+                case 16: // saveCompactData
+                    printf("You've chosen function saveCompactData(), which saves a list to a file in compact form\n");
+                    printf("Please input the index of list (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = saveCompactData(&listArray[input]);
+                    printf(status == OK ? "Saved successfully to `data.bin`!\n" : "Failed to save!\n");
+                    getchar();
+                    break;
+                case 17: // loadCompactData
+                    printf("You've chosen function loadCompactData(), which loads a list from a compact file\n");
+                    printf("Please prepare `data.bin` in current directory!\n");
+                    printf("Please input the index of list which has NOT been initialized (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = loadCompactData(&listArray[input]);
+                    printf(status == OK ? "Loaded successfully!\n" : "Failed to load!\n");
+                    getchar();
+                    break;
+                case 18: // concurrentBenchmark
+                    printf("You've chosen function concurrentBenchmark(), which stress-tests the lock-free set\n");
+                    printf("Please input the max number of threads (from 1 to %d):\n", EPOCH_MAX_THREADS - 1);
+                    if (!scanf("%d", &input) || input >= EPOCH_MAX_THREADS || input < 1) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = concurrentBenchmark(input, 200000, 1000);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 19: // listSort
+                    printf("You've chosen function listSort(), which sorts a list in ascending order\n");
+                    printf("Please input the number of threads (from 1 to %d):\n", SORT_MAX_THREADS);
+                    if (!scanf("%d", &input) || input > SORT_MAX_THREADS || input < 1) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listSort(currentList, input);
+                    printf(status == OK ? "Sorted successfully!\n" : "Failed to sort!\n");
+                    getchar();
+                    break;
+                case 20: // listConcat
+                    printf("You've chosen function listConcat(), which moves another list to the end of this list\n");
+                    printf("Please input the index of list to be moved (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listConcat(currentList, &listArray[input]);
+                    printf(status == OK ? "Concatenated successfully!\n" : "Failed to concatenate!\n");
+                    getchar();
+                    break;
+                case 21: // listSplice
+                    printf("You've chosen function listSplice(), which moves another list into this list\n");
+                    printf("Please input the index of list to be moved (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    printf("Please input the index of element where it will be spliced:\n");
+                    if (!scanf("%d", &element)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listSplice(currentList, element, &listArray[input]);
+                    printf(status == OK ? "Spliced successfully!\n" : "Failed to splice!\n");
+                    getchar();
+                    break;
+                case 22: // listSplitAt
+                    printf("You've chosen function listSplitAt(), which moves the rest of this list to another list\n");
+                    printf("Please input the index of element where it will be split:\n");
+                    if (!scanf("%d", &element)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    printf("Please input the index of an empty list (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listSplitAt(currentList, element, &listArray[input]);
+                    printf(status == OK ? "Split successfully!\n" : "Failed to split!\n");
+                    getchar();
+                    break;
+                case 23: // listBuildIndex
+                    printf("You've chosen function listBuildIndex(), which builds a hash index of a list\n");
+                    status = listBuildIndex(currentList);
+                    printf(status == OK ? "Indexed successfully!\n" : "Failed to index!\n");
+                    getchar();
+                    break;
+                case 24: // listDropIndex
+                    printf("You've chosen function listDropIndex(), which drops the hash index of a list\n");
+                    status = listDropIndex(currentList);
+                    printf(status == OK ? "Dropped successfully!\n" : "Failed to drop!\n");
+                    getchar();
+                    break;
+                case 25: // listDeleteValue
+                    printf("You've chosen function listDeleteValue(), which deletes an element by its value\n");
+                    printf("Please input the value of the element:\n");
+                    if (!scanf("%d", &queryElement)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listDeleteValue(currentList, queryElement);
+                    status == OK ? printf("Succeeded to delete element %d!\n", queryElement)
+                                 : printf("This element doesn't exist!\n");
+                    getchar();
+                    break;
+                case 26: // saveVersion
+                    printf("You've chosen function persistentFromList(), which saves a list as a version\n");
+                    printf("Please input the index of version (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = persistentFromList(&versionArray[input], currentList);
+                    printf(status == OK ? "Saved successfully!\n" : "Failed to save!\n");
+                    getchar();
+                    break;
+                case 27: // restoreVersion
+                    printf("You've chosen function persistentToList(), which restores a version to a list\n");
+                    printf("Please input the index of version (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = persistentToList(currentList, &versionArray[input]);
+                    printf(status == OK ? "Restored successfully!\n" : "Failed to restore! (Is the list initialized?)\n");
+                    getchar();
+                    break;
+                case 28: // listCompact
+                    printf("You've chosen function listCompact(), which relayouts a list in traversal order\n");
+                    status = listCompact(currentList);
+                    printf(status == OK ? "Compacted successfully!\n" : "Failed to compact!\n");
+                    getchar();
+                    break;
+                case 29: // prefetchBenchmark
+                    printf("You've chosen function prefetchBenchmark(), which measures traversal of scattered nodes\n");
+                    printf("Please input the length of list:\n");
+                    if (!scanf("%d", &input) || input < 1) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = prefetchBenchmark(input);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 30: // saveBinaryData
+                    printf("You've chosen function saveDataAs(), which saves a list to a binary file\n");
+                    printf("Please input the index of list (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = saveDataAs(&listArray[input], "data.dat", TRUE);
+                    printf(status == OK ? "Saved successfully to `data.dat`!\n" : "Failed to save!\n");
+                    getchar();
+                    break;
+                case 31: // loadBinaryData
+                    printf("You've chosen function loadDataFrom(), which loads a list from a binary file\n");
+                    printf("Please prepare `data.dat` in current directory!\n");
+                    printf("Please input the index of list which has NOT been initialized (from 0 to 99):\n");
+                    if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = loadDataFrom(&listArray[input], "data.dat");
+                    printf(status == OK ? "Loaded successfully!\n" : "Failed to load!\n");
+                    getchar();
+                    break;
+                case 32: // pushFront
+                    printf("You've chosen function pushFront(), which inserts an element before the first element\n");
+                    printf("Please input the value of it:\n");
+                    if (!scanf("%d", &element)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = pushFront(currentList, element);
+                    status == OK ? printf("Succeeded to insert element %d!\n", element)
+                                 : printf(status == OVERFLOW ? "The list is full!\n" : "Failed to insert!\n");
+                    getchar();
+                    break;
+                case 33: // pushBack
+                    printf("You've chosen function pushBack(), which inserts an element after the last element\n");
+                    printf("Please input the value of it:\n");
+                    if (!scanf("%d", &element)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = pushBack(currentList, element);
+                    status == OK ? printf("Succeeded to insert element %d!\n", element)
+                                 : printf(status == OVERFLOW ? "The list is full!\n" : "Failed to insert!\n");
+                    getchar();
+                    break;
+                case 34: // popFront
+                    printf("You've chosen function popFront(), which deletes the first element\n");
+                    status = popFront(currentList, &element);
+                    status == OK ? printf("Succeeded to delete element %d!\n", element)
+                                 : printf("Failed to delete!\n");
+                    getchar();
+                    break;
+                case 35: // popBack
+                    printf("You've chosen function popBack(), which deletes the last element\n");
+                    status = popBack(currentList, &element);
+                    status == OK ? printf("Succeeded to delete element %d!\n", element)
+                                 : printf("Failed to delete!\n");
+                    getchar();
+                    break;
+                case 36: // peekFront
+                    printf("You've chosen function peekFront(), which gets the first element\n");
+                    status = peekFront(currentList, &element);
+                    status == OK ? printf("The first element is: %d\n", element)
+                                 : printf("Failed to query!\n");
+                    getchar();
+                    break;
+                case 37: // peekBack
+                    printf("You've chosen function peekBack(), which gets the last element\n");
+                    status = peekBack(currentList, &element);
+                    status == OK ? printf("The last element is: %d\n", element)
+                                 : printf("Failed to query!\n");
+                    getchar();
+                    break;
+                case 38: // listSetCapacity
+                    printf("You've chosen function listSetCapacity(), which bounds the length of a list\n");
+                    printf("Please input the capacity (0 for unbounded):\n");
+                    if (!scanf("%d", &input)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listSetCapacity(currentList, input);
+                    printf(status == OK ? "Set successfully!\n" : "Failed to set!\n");
+                    getchar();
+                    break;
+                case 39: // queueBenchmark
+                    printf("You've chosen function queueBenchmark(), which measures a list used as a FIFO queue\n");
+                    status = queueBenchmark(10000000);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 40: // queueConcurrencyBenchmark
+                    printf("You've chosen function queueConcurrencyBenchmark(), which compares the lock-free queue with a locked list\n");
+                    printf("Please input the max number of threads (from 2 to %d):\n", EPOCH_MAX_THREADS - 1);
+                    if (!scanf("%d", &input) || input >= EPOCH_MAX_THREADS || input < 2) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = queueConcurrencyBenchmark(input, 1000000, 16);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 41: // listSetOrganize
+                    printf("You've chosen function listSetOrganize(), which lets locateElem reorder the list\n");
+                    printf("Average probe depth so far: %.2f\n", listProbeDepth(currentList));
+                    printf("Please input the mode (0 for none, 1 for move-to-front, 2 for transpose):\n");
+                    if (!scanf("%d", &input)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listSetOrganize(currentList, input);
+                    printf(status == OK ? "Set successfully!\n" : "Failed to set!\n");
+                    getchar();
+                    break;
+                case 42: // organizeBenchmark
+                    printf("You've chosen function organizeBenchmark(), which measures skewed lookups on self-organizing lists\n");
+                    printf("Please input the length of list:\n");
+                    if (!scanf("%d", &input) || input < 1) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = organizeBenchmark(input, 100000);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 43: // listBuildFilter
+                    printf("You've chosen function listBuildFilter(), which lets lookups of absent values skip the scan\n");
+                    printf("Please input the expected number of elements (0 for current length) and false positive rate:\n");
+                    double rate;
+                    if (scanf("%d%lf", &input, &rate) != 2) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listBuildFilter(currentList, input, rate);
+                    if (status == OK) {
+                        LinkFilter *filter = currentList->filter;
+                        printf("Built filter of %u counters (%u bytes) with %d hashes for %d elements at rate %g\n",
+                               filter->size, filter->size, filter->hashes, filter->capacity, filter->rate);
+                        printf("Estimated false positive rate at current length: %g\n", listFilterRate(currentList));
+                    } else {
+                        printf("Failed to build!\n");
+                    }
+                    getchar();
+                    break;
+                case 44: // listDropFilter
+                    printf("You've chosen function listDropFilter(), which drops the filter of a list\n");
+                    status = listDropFilter(currentList);
+                    printf(status == OK ? "Dropped successfully!\n" : "Failed to drop!\n");
+                    getchar();
+                    break;
+                case 45: // listMarkDead
+                    printf("You've chosen function listMarkDead(), which deletes an element lazily\n");
+                    printf("Please input the value of the element:\n");
+                    if (!scanf("%d", &queryElement)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listMarkDead(currentList, listFind(currentList, queryElement, NULL));
+                    printf(status == OK ? "Marked successfully!\n" : "Failed to mark!\n");
+                    getchar();
+                    break;
+                case 46: // listPurge
+                    printf("You've chosen function listPurge(), which frees all lazily deleted elements\n");
+                    status = listPurge(currentList);
+                    printf(status == OK ? "Purged successfully!\n" : "Failed to purge!\n");
+                    getchar();
+                    break;
+                case 47: // tombstoneBenchmark
+                    printf("You've chosen function tombstoneBenchmark(), which compares eager and lazy deletion\n");
+                    printf("Please input the length of list and the number of elements to be deleted:\n");
+                    int count;
+                    if (scanf("%d%d", &input, &count) != 2 || input < 1 || count < 0 || count > input) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = tombstoneBenchmark(input, count);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 48: // listUseArena
+                    printf("You've chosen function listUseArena(), which lets an empty list be cleared at once\n");
+                    status = listUseArena(currentList);
+                    printf(status == OK ? "Set successfully!\n" : "Failed to set!\n");
+                    getchar();
+                    break;
+                case 49: // arenaBenchmark
+                    printf("You've chosen function arenaBenchmark(), which measures building and clearing a list\n");
+                    printf("Please input the length of list:\n");
+                    if (!scanf("%d", &input) || input < 1) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = arenaBenchmark(input);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                case 50: // listMergeSorted
+                    printf("You've chosen function listMergeSorted(), which merges sorted lists into this empty list\n");
+                    printf("Please input the number of lists, then their indexes (from 0 to 99):\n");
+                    LinkList *sortedLists[TOTAL_LISTS];
+                    if (!scanf("%d", &count) || count < 0 || count > TOTAL_LISTS) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = OK;
+                    for (int i = 0; i < count && status == OK; i++) {
+                        if (!scanf("%d", &input) || input >= TOTAL_LISTS || input < 0) { // invalid input
+                            status = ERROR;
+                        } else {
+                            sortedLists[i] = &listArray[input];
+                        }
+                    }
+                    if (status != OK) {
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = listMergeSorted(currentList, sortedLists, count);
+                    printf(status == OK ? "Merged successfully!\n" : "Failed to merge!\n");
+                    getchar();
+                    break;
+                case 51: // arrayBenchmark
+                    printf("You've chosen function arrayBenchmark(), which measures building lists from arrays\n");
+                    printf("Please input the length of list:\n");
+                    if (!scanf("%d", &input) || input < 16) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    status = arrayBenchmark(input, 16);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
                 default: // invalid input
                     printf("You entered an invalid value!\n");
                     getchar();
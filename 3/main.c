@@ -11,7 +11,7 @@ int main() {
     do {
         showMenu();
         printf("Current binaryTree: T%d\n", currentBinaryTreeIndex);
-        printf("Please input your option[0-24]:\n");
+        printf("Please input your option[0-36]:\n");
         int isValid = scanf("%d", &option);
         if (!isValid) {
             printf("You entered an invalid value!\n");
@@ -241,6 +241,10 @@ int main() {
                         break;
                     }
                     printf(status == OK ? "Inserted successfully!\n" : "Failed to insert!\n");
+                    if (status != OK) { // `newTree` is only taken over on success
+                        destroyBinaryTree(newTree);
+                        free(newTree);
+                    }
                     getchar();
                     break;
                 }
@@ -324,7 +328,14 @@ int main() {
                         while (getchar() != '\n');
                         break;
                     }
-                    Status status = saveData(&binaryTreeArray[index]);
+                    printf("Please input the format (0: text, 1: binary, 2: compact binary):\n");
+                    FileFormat format;
+                    if (!scanf("%d", &format)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = saveData(&binaryTreeArray[index], format);
                     printf(status == OK ? "Saved successfully to `data.txt`!\n" : "Failed to save!\n");
                     getchar();
                     break;
@@ -350,6 +361,167 @@ int main() {
                     getchar();
                     break;
                 }
+                case 25: { // memoryReport
+                    printf("You've chosen function memoryReport(), which shows the memory used by a binaryTree\n");
+                    Status status = memoryReport(currentBinaryTree);
+                    status != OK && printf("Failed to report!\n");
+                    getchar();
+                    break;
+                }
+                case 26: { // getAncestors
+                    printf("You've chosen function getAncestors(), which gets the path from a node up to root\n");
+                    printf("Please input the key of the node:\n");
+                    int key;
+                    if (!scanf("%d", &key)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    int depth = nodeDepth(currentBinaryTree, key);
+                    if (depth == ERROR) {
+                        printf("This node doesn't exist!\n");
+                        getchar();
+                        break;
+                    }
+                    TreeNode **ancestors = (TreeNode **) malloc(sizeof(TreeNode *) * depth);
+                    if (!ancestors) {
+                        printf("Overflow!\n");
+                        getchar();
+                        break;
+                    }
+                    int count = getAncestors(currentBinaryTree, key, ancestors);
+                    printf("The depth of this node is %d, keys of its ancestors are:\n", depth);
+                    for (int i = 0; i < count; i++) {
+                        printf("%d ", ancestors[i]->data.key);
+                    }
+                    printf("\n");
+                    free(ancestors);
+                    getchar();
+                    break;
+                }
+                case 27: { // createBenchmark
+                    printf("You've chosen function createBenchmark(), which measures creating large trees\n");
+                    printf("Please input the number of nodes:\n");
+                    int length;
+                    if (!scanf("%d", &length) || length <= 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = createBenchmark(length);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                }
+                case 28: { // traverseBenchmark
+                    printf("You've chosen function traverseBenchmark(), which measures traversing large trees\n");
+                    printf("Please input the number of nodes:\n");
+                    int length;
+                    if (!scanf("%d", &length) || length <= 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = traverseBenchmark(length);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                }
+                case 29: { // levelTraverse
+                    printf("You've chosen function levelTraverse(), which shows a tree level by level\n");
+                    Status status = levelTraverse(currentBinaryTree, showLevel);
+                    status != OK && printf("Failed to traverse!\n");
+                    getchar();
+                    break;
+                }
+                case 30: { // compactBinaryTree
+                    printf("You've chosen function compactBinaryTree(), which lays out nodes in pre order\n");
+                    Status status = compactBinaryTree(currentBinaryTree);
+                    printf(status == OK ? "Compacted successfully!\n" : "Failed to compact!\n");
+                    getchar();
+                    break;
+                }
+                case 31: { // orderBinaryTree
+                    printf("You've chosen function orderBinaryTree(), which turns a binaryTree into a balanced search tree\n");
+                    Status status = orderBinaryTree(currentBinaryTree);
+                    printf(status == OK ? "Ordered successfully!\n" : "Failed to order!\n");
+                    getchar();
+                    break;
+                }
+                case 32: { // orderedInsert
+                    printf("You've chosen function orderedInsert(), which inserts an element into an ordered binaryTree\n");
+                    printf("Please input the key and value of the element:\n");
+                    ElemType e;
+                    if (scanf("%d %d", &e.key, &e.value) != 2) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = orderedInsert(currentBinaryTree, e);
+                    printf(status == OK ? "Inserted successfully!\n" : "Failed to insert!\n");
+                    getchar();
+                    break;
+                }
+                case 33: { // orderedDelete
+                    printf("You've chosen function orderedDelete(), which deletes an element from an ordered binaryTree\n");
+                    printf("Please input the key of the element:\n");
+                    int key;
+                    if (!scanf("%d", &key)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = orderedDelete(currentBinaryTree, key);
+                    printf(status == OK ? "Deleted successfully!\n" : "Failed to delete!\n");
+                    getchar();
+                    break;
+                }
+                case 34: { // lowerBound/upperBound
+                    printf("You've chosen function lowerBound() and upperBound(), which find the bounds of a key\n");
+                    printf("Please input the key:\n");
+                    int key;
+                    if (!scanf("%d", &key)) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    TreeNode *lower = lowerBound(currentBinaryTree, key);
+                    TreeNode *upper = upperBound(currentBinaryTree, key);
+                    lower ? printf("The first key not less than %d is: %d, value: %d\n", key, lower->data.key, lower->data.value)
+                          : printf("No key is not less than %d!\n", key);
+                    upper ? printf("The first key greater than %d is: %d, value: %d\n", key, upper->data.key, upper->data.value)
+                          : printf("No key is greater than %d!\n", key);
+                    getchar();
+                    break;
+                }
+                case 35: { // orderedBenchmark
+                    printf("You've chosen function orderedBenchmark(), which measures an ordered binaryTree\n");
+                    printf("Please input the number of nodes:\n");
+                    int length;
+                    if (!scanf("%d", &length) || length <= 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = orderedBenchmark(length);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                }
+                case 36: { // bplusBenchmark
+                    printf("You've chosen function bplusBenchmark(), which compares a bplusTree with an ordered binaryTree\n");
+                    printf("Please input the number of keys:\n");
+                    int length;
+                    if (!scanf("%d", &length) || length <= 0) { // invalid input
+                        printf("Invalid value!\n");
+                        while (getchar() != '\n');
+                        break;
+                    }
+                    Status status = bplusBenchmark(length);
+                    printf(status == OK ? "Benchmark passed!\n" : "Benchmark failed!\n");
+                    getchar();
+                    break;
+                }
                 default: { // invalid input
                     printf("You entered an invalid value!\n");
                     getchar();
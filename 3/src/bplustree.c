@@ -0,0 +1,644 @@
+#include "functions.h"
+#if defined(BPLUS_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Initialize a bplusTree
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @return {Status} - execution status
+ */
+Status bplusInitialize(BPlusTree *bplusTree) {
+    if (bplusTree->initialized) { // already exists
+        return ERROR;
+    }
+
+    // initialize
+    bplusTree->root = NULL;
+    bplusTree->first = NULL;
+    bplusTree->size = 0;
+    bplusTree->height = 0;
+    bplusTree->initialized = TRUE;
+    return OK;
+}
+
+/**
+ * Free a subtree of a bplusTree
+ * @param {BPlusNode *} node - root of the subtree
+ * @return {void}
+ */
+void bplusFree(BPlusNode *node) {
+    if (!node) {
+        return;
+    }
+    if (!node->isLeaf) { // height is logarithmic, so is the recursion
+        for (int i = 0; i <= node->count; i++) {
+            bplusFree(((BPlusInner *) node)->children[i]);
+        }
+    }
+    free(node);
+}
+
+/**
+ * Destroy a bplusTree
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @return {Status} - execution status
+ */
+Status bplusDestroy(BPlusTree *bplusTree) {
+    if (!bplusTree->initialized) { // bplusTree doesn't exist
+        return ERROR;
+    }
+    bplusFree(bplusTree->root);
+    bplusTree->root = NULL;
+    bplusTree->first = NULL;
+    bplusTree->size = 0;
+    bplusTree->height = 0;
+    bplusTree->initialized = FALSE;
+    return OK;
+}
+
+/**
+ * Fill unused keys of a node with INT32_MAX, which the search relies on
+ * @param {BPlusNode *} node - node
+ * @return {void}
+ */
+void bplusPad(BPlusNode *node) {
+    for (int i = node->count; i < BPLUS_KEYS; i++) {
+        node->keys[i] = INT32_MAX;
+    }
+}
+
+/**
+ * Count the keys of a node less than a key, i.e. the position of its lower bound
+ * @param {BPlusNode *} node - node
+ * @param {int} key - key
+ * @return {int}
+ */
+int bplusRank(BPlusNode *node, int key) {
+#if defined(BPLUS_SIMD) && defined(__SSE2__)
+    // compare 4 keys at a time, padding is never less than the key
+    __m128i needle = _mm_set1_epi32(key), less = _mm_setzero_si128();
+    for (int i = 0; i < node->count; i += 4) {
+        __m128i keys = _mm_loadu_si128((const __m128i *) &node->keys[i]);
+        less = _mm_sub_epi32(less, _mm_cmpgt_epi32(needle, keys)); // true lanes are -1
+    }
+    less = _mm_add_epi32(less, _mm_shuffle_epi32(less, _MM_SHUFFLE(1, 0, 3, 2)));
+    less = _mm_add_epi32(less, _mm_shuffle_epi32(less, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(less);
+#else
+    int low = 0, high = node->count;
+    while (low < high) { // binary search
+        int middle = (low + high) / 2;
+        if (node->keys[middle] < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+#endif
+}
+
+/**
+ * Find the child of an inner node whose subtree may hold a key
+ * @param {BPlusNode *} node - inner node
+ * @param {int} key - key
+ * @return {int} - index of the child
+ */
+int bplusChild(BPlusNode *node, int key) {
+    int slot = bplusRank(node, key);
+    return slot < node->count && node->keys[slot] == key ? slot + 1 : slot;
+}
+
+/**
+ * Find the leaf of a bplusTree which may hold a key
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @param {int} key - key
+ * @return {BPlusLeaf *} - NULL if the tree is empty
+ */
+BPlusLeaf *bplusFindLeaf(BPlusTree *bplusTree, int key) {
+    BPlusNode *node = bplusTree->root;
+    while (node && !node->isLeaf) {
+        node = ((BPlusInner *) node)->children[bplusChild(node, key)];
+    }
+    return (BPlusLeaf *) node;
+}
+
+/**
+ * Find the value of a key
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @param {int} key - key
+ * @param {Value *} value - output, value of the key
+ * @return {Status} - execution status, ERROR if the key doesn't exist
+ */
+Status bplusFind(BPlusTree *bplusTree, int key, Value *value) {
+    if (!bplusTree->initialized) { // bplusTree doesn't exist
+        return ERROR;
+    }
+    BPlusLeaf *leaf = bplusFindLeaf(bplusTree, key);
+    if (!leaf) {
+        return ERROR;
+    }
+    int position = bplusRank(&leaf->node, key);
+    if (position == leaf->node.count || leaf->node.keys[position] != key) {
+        return ERROR;
+    }
+    *value = leaf->values[position];
+    return OK;
+}
+
+/**
+ * Insert a key and its value, or replace the value of an existing key
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @param {int} key - key
+ * @param {Value} value - value
+ * @return {Status} - execution status
+ */
+Status bplusInsert(BPlusTree *bplusTree, int key, Value value) {
+    if (!bplusTree->initialized) { // bplusTree doesn't exist
+        return ERROR;
+    }
+    if (!bplusTree->root) { // first key
+        BPlusLeaf *leaf = (BPlusLeaf *) malloc(sizeof(BPlusLeaf));
+        if (!leaf) {
+            return OVERFLOW;
+        }
+        leaf->node.count = 0;
+        leaf->node.isLeaf = TRUE;
+        leaf->next = NULL;
+        bplusPad(&leaf->node);
+        bplusTree->root = &leaf->node;
+        bplusTree->first = leaf;
+        bplusTree->height = 1;
+    }
+    // a node of BPLUS_MIN_KEYS keys has more than 16 children, so int keys never fill BPLUS_MAX_HEIGHT levels
+    BPlusInner *path[BPLUS_MAX_HEIGHT];
+    int slots[BPLUS_MAX_HEIGHT];
+    int depth = 0;
+    BPlusNode *node = bplusTree->root;
+    while (!node->isLeaf) {
+        path[depth] = (BPlusInner *) node;
+        slots[depth] = bplusChild(node, key);
+        node = path[depth]->children[slots[depth]];
+        depth++;
+    }
+    BPlusLeaf *leaf = (BPlusLeaf *) node;
+    int count = leaf->node.count;
+    int position = bplusRank(node, key);
+    if (position < count && leaf->node.keys[position] == key) {
+        leaf->values[position] = value;
+        return OK;
+    }
+    if (count < BPLUS_KEYS) {
+        memmove(&leaf->node.keys[position + 1], &leaf->node.keys[position], sizeof(int) * (count - position));
+        memmove(&leaf->values[position + 1], &leaf->values[position], sizeof(Value) * (count - position));
+        leaf->node.keys[position] = key;
+        leaf->values[position] = value;
+        leaf->node.count++;
+        bplusTree->size++;
+        return OK;
+    }
+
+    // allocate every node the splits need first, so that running out of memory leaves the tree intact
+    int splits = 1;
+    while (splits <= depth && path[depth - splits]->node.count == BPLUS_KEYS) {
+        splits++;
+    }
+    int needed = splits > depth ? splits + 1 : splits; // a new root if the splits reach the old one
+    BPlusNode *nodes[BPLUS_MAX_HEIGHT + 1];
+    for (int i = 0; i < needed; i++) { // the leaf first, then inner nodes
+        nodes[i] = (BPlusNode *) malloc(i ? sizeof(BPlusInner) : sizeof(BPlusLeaf));
+        if (!nodes[i]) {
+            while (i--) {
+                free(nodes[i]);
+            }
+            return OVERFLOW;
+        }
+    }
+
+    // split the leaf, the right one takes the upper half of BPLUS_KEYS + 1 pairs
+    int keys[BPLUS_KEYS + 1];
+    Value values[BPLUS_KEYS + 1];
+    memcpy(keys, leaf->node.keys, sizeof(int) * position);
+    memcpy(values, leaf->values, sizeof(Value) * position);
+    keys[position] = key;
+    values[position] = value;
+    memcpy(&keys[position + 1], &leaf->node.keys[position], sizeof(int) * (count - position));
+    memcpy(&values[position + 1], &leaf->values[position], sizeof(Value) * (count - position));
+    int left = (BPLUS_KEYS + 2) / 2;
+    BPlusLeaf *right = (BPlusLeaf *) nodes[0];
+    right->node.isLeaf = TRUE;
+    right->node.count = BPLUS_KEYS + 1 - left;
+    leaf->node.count = left;
+    memcpy(leaf->node.keys, keys, sizeof(int) * left);
+    memcpy(leaf->values, values, sizeof(Value) * left);
+    memcpy(right->node.keys, &keys[left], sizeof(int) * right->node.count);
+    memcpy(right->values, &values[left], sizeof(Value) * right->node.count);
+    bplusPad(&leaf->node);
+    bplusPad(&right->node);
+    right->next = leaf->next;
+    leaf->next = right;
+    bplusTree->size++;
+
+    // insert the separator into the parents, splitting the full ones
+    int separator = right->node.keys[0];
+    BPlusNode *child = &right->node;
+    for (int i = 1; depth; i++) {
+        BPlusInner *parent = path[--depth];
+        int slot = slots[depth];
+        count = parent->node.count;
+        if (count < BPLUS_KEYS) {
+            memmove(&parent->node.keys[slot + 1], &parent->node.keys[slot], sizeof(int) * (count - slot));
+            memmove(&parent->children[slot + 2], &parent->children[slot + 1], sizeof(BPlusNode *) * (count - slot));
+            parent->node.keys[slot] = separator;
+            parent->children[slot + 1] = child;
+            parent->node.count++;
+            return OK;
+        }
+        BPlusNode *children[BPLUS_KEYS + 2];
+        memcpy(keys, parent->node.keys, sizeof(int) * slot);
+        memcpy(children, parent->children, sizeof(BPlusNode *) * (slot + 1));
+        keys[slot] = separator;
+        children[slot + 1] = child;
+        memcpy(&keys[slot + 1], &parent->node.keys[slot], sizeof(int) * (count - slot));
+        memcpy(&children[slot + 2], &parent->children[slot + 1], sizeof(BPlusNode *) * (count - slot));
+        // left keeps BPLUS_KEYS / 2 keys, the next one moves up, right takes the rest
+        left = BPLUS_KEYS / 2;
+        BPlusInner *sibling = (BPlusInner *) nodes[i];
+        sibling->node.isLeaf = FALSE;
+        sibling->node.count = BPLUS_KEYS - left;
+        parent->node.count = left;
+        memcpy(parent->node.keys, keys, sizeof(int) * left);
+        memcpy(parent->children, children, sizeof(BPlusNode *) * (left + 1));
+        memcpy(sibling->node.keys, &keys[left + 1], sizeof(int) * sibling->node.count);
+        memcpy(sibling->children, &children[left + 1], sizeof(BPlusNode *) * (sibling->node.count + 1));
+        bplusPad(&parent->node);
+        bplusPad(&sibling->node);
+        separator = keys[left];
+        child = &sibling->node;
+    }
+
+    // the root was split
+    BPlusInner *root = (BPlusInner *) nodes[splits];
+    root->node.isLeaf = FALSE;
+    root->node.count = 1;
+    root->node.keys[0] = separator;
+    root->children[0] = bplusTree->root;
+    root->children[1] = child;
+    bplusPad(&root->node);
+    bplusTree->root = &root->node;
+    bplusTree->height++;
+    return OK;
+}
+
+/**
+ * Merge a child of an inner node with its right sibling
+ * @param {BPlusInner *} parent - inner node
+ * @param {int} slot - index of the left child
+ * @return {void}
+ */
+void bplusMerge(BPlusInner *parent, int slot) {
+    BPlusNode *left = parent->children[slot], *right = parent->children[slot + 1];
+    if (left->isLeaf) {
+        memcpy(&left->keys[left->count], right->keys, sizeof(int) * right->count);
+        memcpy(&((BPlusLeaf *) left)->values[left->count], ((BPlusLeaf *) right)->values,
+               sizeof(Value) * right->count);
+        ((BPlusLeaf *) left)->next = ((BPlusLeaf *) right)->next;
+        left->count += right->count;
+    } else { // the separator comes down between the two
+        left->keys[left->count] = parent->node.keys[slot];
+        memcpy(&left->keys[left->count + 1], right->keys, sizeof(int) * right->count);
+        memcpy(&((BPlusInner *) left)->children[left->count + 1], ((BPlusInner *) right)->children,
+               sizeof(BPlusNode *) * (right->count + 1));
+        left->count += right->count + 1;
+    }
+    free(right);
+    int count = parent->node.count;
+    memmove(&parent->node.keys[slot], &parent->node.keys[slot + 1], sizeof(int) * (count - slot - 1));
+    memmove(&parent->children[slot + 1], &parent->children[slot + 2], sizeof(BPlusNode *) * (count - slot - 1));
+    parent->node.count--;
+    bplusPad(&parent->node);
+}
+
+/**
+ * Refill a child of an inner node which has fewer than BPLUS_MIN_KEYS keys,
+ * borrowing a key from a sibling or merging with it
+ * @param {BPlusInner *} parent - inner node
+ * @param {int} slot - index of the child
+ * @return {void}
+ */
+void bplusRebalance(BPlusInner *parent, int slot) {
+    BPlusNode *child = parent->children[slot];
+    BPlusNode *left = slot > 0 ? parent->children[slot - 1] : NULL;
+    BPlusNode *right = slot < parent->node.count ? parent->children[slot + 1] : NULL;
+    if (left && left->count > BPLUS_MIN_KEYS) { // borrow the last key of left sibling
+        memmove(&child->keys[1], child->keys, sizeof(int) * child->count);
+        if (child->isLeaf) {
+            Value *values = ((BPlusLeaf *) child)->values;
+            memmove(&values[1], values, sizeof(Value) * child->count);
+            values[0] = ((BPlusLeaf *) left)->values[left->count - 1];
+            child->keys[0] = left->keys[left->count - 1];
+            parent->node.keys[slot - 1] = child->keys[0];
+        } else {
+            BPlusNode **children = ((BPlusInner *) child)->children;
+            memmove(&children[1], children, sizeof(BPlusNode *) * (child->count + 1));
+            children[0] = ((BPlusInner *) left)->children[left->count];
+            child->keys[0] = parent->node.keys[slot - 1];
+            parent->node.keys[slot - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+        bplusPad(left);
+    } else if (right && right->count > BPLUS_MIN_KEYS) { // borrow the first key of right sibling
+        if (child->isLeaf) {
+            Value *values = ((BPlusLeaf *) right)->values;
+            child->keys[child->count] = right->keys[0];
+            ((BPlusLeaf *) child)->values[child->count] = values[0];
+            memmove(values, &values[1], sizeof(Value) * (right->count - 1));
+            parent->node.keys[slot] = right->keys[1];
+        } else {
+            BPlusNode **children = ((BPlusInner *) right)->children;
+            child->keys[child->count] = parent->node.keys[slot];
+            ((BPlusInner *) child)->children[child->count + 1] = children[0];
+            memmove(children, &children[1], sizeof(BPlusNode *) * right->count);
+            parent->node.keys[slot] = right->keys[0];
+        }
+        memmove(right->keys, &right->keys[1], sizeof(int) * (right->count - 1));
+        child->count++;
+        right->count--;
+        bplusPad(right);
+    } else if (left) {
+        bplusMerge(parent, slot - 1);
+    } else {
+        bplusMerge(parent, slot);
+    }
+}
+
+/**
+ * Delete a key and its value
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @param {int} key - key
+ * @return {Status} - execution status, ERROR if the key doesn't exist
+ */
+Status bplusDelete(BPlusTree *bplusTree, int key) {
+    if (!bplusTree->initialized || !bplusTree->root) { // bplusTree doesn't exist or is empty
+        return ERROR;
+    }
+    BPlusInner *path[BPLUS_MAX_HEIGHT];
+    int slots[BPLUS_MAX_HEIGHT];
+    int depth = 0;
+    BPlusNode *node = bplusTree->root;
+    while (!node->isLeaf) {
+        path[depth] = (BPlusInner *) node;
+        slots[depth] = bplusChild(node, key);
+        node = path[depth]->children[slots[depth]];
+        depth++;
+    }
+    BPlusLeaf *leaf = (BPlusLeaf *) node;
+    int position = bplusRank(node, key);
+    if (position == node->count || node->keys[position] != key) { // key doesn't exist
+        return ERROR;
+    }
+    memmove(&node->keys[position], &node->keys[position + 1], sizeof(int) * (node->count - position - 1));
+    memmove(&leaf->values[position], &leaf->values[position + 1], sizeof(Value) * (node->count - position - 1));
+    node->count--;
+    bplusPad(node);
+    bplusTree->size--;
+
+    // separators equal to a deleted key still split their children correctly, only underflow needs work
+    while (depth--) {
+        if (path[depth]->children[slots[depth]]->count >= BPLUS_MIN_KEYS) {
+            break;
+        }
+        bplusRebalance(path[depth], slots[depth]);
+    }
+    BPlusNode *root = bplusTree->root;
+    if (!root->isLeaf && root->count == 0) { // root lost its last separator
+        bplusTree->root = ((BPlusInner *) root)->children[0];
+        bplusTree->height--;
+        free(root);
+    } else if (root->isLeaf && root->count == 0) {
+        free(root);
+        bplusTree->root = NULL;
+        bplusTree->first = NULL;
+        bplusTree->height = 0;
+    }
+    return OK;
+}
+
+/**
+ * Visit keys from low to high in order along the linked leaves
+ * @param {BPlusTree *} bplusTree - pointer to a bplusTree
+ * @param {int} low - smallest key
+ * @param {int} high - largest key
+ * @param {void (*)(ElemType)} visitor - visit function, or NULL to count only
+ * @return {int} - number of keys visited, ERROR if the tree doesn't exist
+ */
+int bplusRange(BPlusTree *bplusTree, int low, int high, void (*visitor)(ElemType e)) {
+    if (!bplusTree->initialized) { // bplusTree doesn't exist
+        return ERROR;
+    }
+    if (low > high) {
+        return 0;
+    }
+    BPlusLeaf *leaf = bplusFindLeaf(bplusTree, low);
+    int position = leaf ? bplusRank(&leaf->node, low) : 0;
+    int count = 0;
+    for (; leaf; leaf = leaf->next, position = 0) {
+        for (; position < leaf->node.count; position++) {
+            if (leaf->node.keys[position] > high) {
+                return count;
+            }
+            if (visitor) {
+                ElemType e = {leaf->node.keys[position], leaf->values[position]};
+                visitor(e);
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Build an empty bplusTree from elements sorted by key, filling nodes evenly
+ * @param {BPlusTree *} bplusTree - pointer to an empty bplusTree
+ * @param {ElemType *} elements - elements in strictly ascending key order
+ * @param {int} length - number of elements
+ * @return {Status} - execution status
+ */
+Status bplusBulkLoad(BPlusTree *bplusTree, ElemType *elements, int length) {
+    if (!bplusTree->initialized || bplusTree->root || length < 0) {
+        return ERROR;
+    }
+    for (int i = 1; i < length; i++) {
+        if (elements[i - 1].key >= elements[i].key) { // not sorted or duplicated
+            return ERROR;
+        }
+    }
+    if (length == 0) {
+        return OK;
+    }
+    int count = (length + BPLUS_KEYS - 1) / BPLUS_KEYS; // nodes of the current level
+    BPlusNode **level = (BPlusNode **) malloc(sizeof(BPlusNode *) * count);
+    int *firstKeys = (int *) malloc(sizeof(int) * count); // smallest key below each node
+    if (!level || !firstKeys) {
+        free(level);
+        free(firstKeys);
+        return OVERFLOW;
+    }
+
+    // leaves, more than length / count >= BPLUS_MIN_KEYS keys each unless there is one
+    Status status = OK;
+    BPlusLeaf *previous = NULL;
+    for (int i = 0, next = 0; i < count; i++) {
+        BPlusLeaf *leaf = (BPlusLeaf *) malloc(sizeof(BPlusLeaf));
+        if (!leaf) {
+            while (i--) {
+                free(level[i]);
+            }
+            status = OVERFLOW;
+            break;
+        }
+        leaf->node.isLeaf = TRUE;
+        leaf->node.count = length / count + (i < length % count);
+        for (int j = 0; j < leaf->node.count; j++, next++) {
+            leaf->node.keys[j] = elements[next].key;
+            leaf->values[j] = elements[next].value;
+        }
+        bplusPad(&leaf->node);
+        leaf->next = NULL;
+        if (previous) {
+            previous->next = leaf;
+        }
+        previous = leaf;
+        level[i] = &leaf->node;
+        firstKeys[i] = leaf->node.keys[0];
+    }
+    int height = 1;
+
+    // inner levels, built in place over the level below
+    while (status == OK && count > 1) {
+        int parents = (count + BPLUS_KEYS) / (BPLUS_KEYS + 1);
+        for (int i = 0, next = 0; i < parents; i++) {
+            BPlusInner *parent = (BPlusInner *) malloc(sizeof(BPlusInner));
+            if (!parent) {
+                for (int j = 0; j < i; j++) { // built parents, then children not yet adopted
+                    bplusFree(level[j]);
+                }
+                for (int j = next; j < count; j++) {
+                    bplusFree(level[j]);
+                }
+                status = OVERFLOW;
+                break;
+            }
+            int children = count / parents + (i < count % parents);
+            parent->node.isLeaf = FALSE;
+            parent->node.count = children - 1;
+            int firstKey = firstKeys[next];
+            for (int j = 0; j < children; j++, next++) {
+                parent->children[j] = level[next];
+                if (j) {
+                    parent->node.keys[j - 1] = firstKeys[next];
+                }
+            }
+            bplusPad(&parent->node);
+            level[i] = &parent->node;
+            firstKeys[i] = firstKey;
+        }
+        count = parents;
+        height++;
+    }
+    if (status == OK) {
+        bplusTree->root = level[0];
+        bplusTree->first = (BPlusLeaf *) bplusFindLeaf(bplusTree, INT32_MIN);
+        bplusTree->size = length;
+        bplusTree->height = height;
+    }
+    free(level);
+    free(firstKeys);
+    return status;
+}
+
+/**
+ * Benchmark of point lookups in a bplusTree and in an ordered binaryTree with keys 0 to length - 1
+ * @param {int} length - number of keys
+ * @return {Status} - execution status
+ */
+Status bplusBenchmark(int length) {
+    if (length < 1) {
+        return ERROR;
+    }
+    ElemType *preOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    ElemType *inOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    int *queries = (int *) malloc(sizeof(int) * length);
+    if (!preOrder || !inOrder || !queries) {
+        free(preOrder);
+        free(inOrder);
+        free(queries);
+        return OVERFLOW;
+    }
+    shapeHelper(preOrder, inOrder, length, 2);
+    uint32_t seed = 2463534242u;
+    for (int i = 0; i < length; i++) { // xorshift, about half of the keys exist
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        queries[i] = (int) (seed % (2u * (uint32_t) length));
+    }
+
+    BPlusTree bplusTree;
+    bplusTree.initialized = FALSE;
+    bplusInitialize(&bplusTree);
+    clock_t start = clock();
+    Status status = bplusBulkLoad(&bplusTree, inOrder, length);
+    printf("bplus tree:  %d keys bulk loaded in %.3f s, height %d\n", length,
+           (double) (clock() - start) / CLOCKS_PER_SEC, bplusTree.height);
+    BinaryTree binaryTree;
+    binaryTree.initialized = FALSE;
+    initializeBinaryTree(&binaryTree);
+    if (status == OK) {
+        status = createBinaryTree(&binaryTree, preOrder, inOrder, length);
+    }
+    if (status == OK) {
+        status = orderBinaryTree(&binaryTree);
+    }
+
+    if (status == OK) {
+        long long found = 0;
+        Value value;
+        start = clock();
+        for (int i = 0; i < length; i++) {
+            found += bplusFind(&bplusTree, queries[i], &value) == OK;
+        }
+        printf("bplus tree:  %lld of %d lookups found in %.3f s\n", found, length,
+               (double) (clock() - start) / CLOCKS_PER_SEC);
+        found = 0;
+        start = clock();
+        for (int i = 0; i < length; i++) {
+            TreeNode *node = lowerBound(&binaryTree, queries[i]);
+            found += node && node->data.key == queries[i];
+        }
+        printf("binary tree: %lld of %d lookups found in %.3f s, depth %d\n", found, length,
+               (double) (clock() - start) / CLOCKS_PER_SEC, binaryTreeDepth(&binaryTree));
+        start = clock();
+        int count = bplusRange(&bplusTree, INT32_MIN, INT32_MAX, NULL);
+        printf("bplus tree:  %d keys scanned in %.3f s\n", count, (double) (clock() - start) / CLOCKS_PER_SEC);
+        start = clock();
+        for (int i = 0; i < length && status == OK; i++) {
+            status = bplusInsert(&bplusTree, length + i, i);
+        }
+        printf("bplus tree:  %d keys inserted in %.3f s\n", length, (double) (clock() - start) / CLOCKS_PER_SEC);
+        start = clock();
+        for (int i = 0; i < length && status == OK; i++) {
+            bplusDelete(&bplusTree, queries[i]);
+        }
+        printf("bplus tree:  %d deletions in %.3f s, %d keys left\n", length,
+               (double) (clock() - start) / CLOCKS_PER_SEC, bplusTree.size);
+    }
+    bplusDestroy(&bplusTree);
+    destroyBinaryTree(&binaryTree);
+    free(preOrder);
+    free(inOrder);
+    free(queries);
+    return status;
+}
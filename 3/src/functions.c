@@ -12,6 +12,15 @@ Status initializeBinaryTree(BinaryTree *binaryTree) {
 
     // initialize
     binaryTree->root = NULL;
+    binaryTree->blocks = NULL;
+    binaryTree->freeNodes = NULL;
+    binaryTree->freeCount = 0;
+    binaryTree->index.entries = NULL;
+    binaryTree->index.bits = 0;
+    binaryTree->index.size = 0;
+    binaryTree->stack = NULL;
+    binaryTree->stackSize = 0;
+    binaryTree->ordered = FALSE;
     binaryTree->initialized = TRUE;
     return OK;
 }
@@ -59,37 +68,192 @@ void postOrderTraverse(TreeNode *node, void (*visitor)(TreeNode *)) {
 }
 
 /**
- * Traverses a tree level-orderly
- * @param {TreeNode *} node - pointer to a node
- * @param {int} length - length of node
- * @param {void (*)(ElemType)} visitor - visit function
+ * Traverses a tree level-orderly with the reserved stack of the binaryTree as queue.
+ * Any level has at most (length + 1) / 2 nodes, as no node of a level is an
+ * ancestor of another, so the stack holds the current and the next level in
+ * two halves and every level is contiguous
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {void (*)(TreeNode *)} visitor - visit function for each node, or NULL
+ * @param {void (*)(TreeNode **, int, int)} levelVisitor - visit function for each level, or NULL
  * @return {void}
  */
-void levelOrderTraverse(TreeNode **list, int length, void (*visitor)(TreeNode *)) {
-    if (length <= 0) { // recurse until list length is 0
+void levelOrderTraverse(BinaryTree *binaryTree, void (*visitor)(TreeNode *),
+                        void (*levelVisitor)(TreeNode **level, int count, int depth)) {
+    if (!binaryTree->root) {
         return;
     }
-    TreeNode **newList = (TreeNode **) malloc(sizeof(TreeNode *) * length * 2);
-    int newLength = 0;
-    // push children into list if exist
-    for (int i = 0; i < length; i++) {
-        visitor(list[i]);
-        if (list[i]->leftChild) {
-            newList[newLength] = list[i]->leftChild;
-            newLength++;
+    int width = (binaryTree->index.size + 1) / 2;
+    TreeNode **level = binaryTree->stack, **next = binaryTree->stack + width;
+    int count = 1;
+    level[0] = binaryTree->root;
+    for (int depth = 0; count; depth++) {
+        int nextCount = 0;
+        for (int i = 0; i < count; i++) { // push children of this level into the other half
+            TreeNode *node = level[i];
+            if (visitor) {
+                visitor(node);
+            }
+            if (node->leftChild) {
+                next[nextCount++] = node->leftChild;
+            }
+            if (node->rightChild) {
+                next[nextCount++] = node->rightChild;
+            }
+        }
+        if (levelVisitor) {
+            levelVisitor(level, count, depth);
+        }
+        TreeNode **swap = level;
+        level = next;
+        next = swap;
+        count = nextCount;
+    }
+}
+
+/**
+ * Traverse the binaryTree level by level
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {void (*)(TreeNode **, int, int)} visitor - receives the nodes, their count and depth of each level
+ * @return {Status} - execution status
+ */
+Status levelTraverse(BinaryTree *binaryTree, void (*visitor)(TreeNode **level, int count, int depth)) {
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
+        return ERROR;
+    }
+    if (stackReserve(binaryTree) != OK) {
+        return OVERFLOW;
+    }
+    levelOrderTraverse(binaryTree, NULL, visitor);
+    return OK;
+}
+
+/**
+ * Make the traversal stack of a binaryTree large enough for its deepest path
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @return {Status} - execution status
+ */
+Status stackReserve(BinaryTree *binaryTree) {
+    int size = binaryTree->index.size + 1; // no path is longer than the tree, no two levels are either
+    if (size <= binaryTree->stackSize) {
+        return OK;
+    }
+    TreeNode **stack = (TreeNode **) realloc(binaryTree->stack, sizeof(TreeNode *) * size);
+    if (!stack) {
+        return OVERFLOW;
+    }
+    binaryTree->stack = stack;
+    binaryTree->stackSize = size;
+    return OK;
+}
+
+/**
+ * Traverses a tree with the explicit stack of the binaryTree, which must be reserved
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TraversalOrder} traversalOrder - PRE_ORDER, IN_ORDER or POST_ORDER
+ * @param {void (*)(ElemType)} visitor - visit function
+ * @return {void}
+ */
+void stackTraverse(BinaryTree *binaryTree, TraversalOrder traversalOrder, void (*visitor)(TreeNode *)) {
+    TreeNode **stack = binaryTree->stack;
+    TreeNode *node = binaryTree->root, *last = NULL;
+    int top = 0;
+    while (node || top) {
+        if (node) { // go down the left path
+            if (traversalOrder == PRE_ORDER) {
+                visitor(node);
+            }
+            stack[top++] = node;
+            node = node->leftChild;
+        } else if (traversalOrder != POST_ORDER) { // left subtree done, continue with right one
+            node = stack[--top];
+            if (traversalOrder == IN_ORDER) {
+                visitor(node);
+            }
+            node = node->rightChild;
+        } else { // the node stays on the stack until its right subtree is done
+            TreeNode *waiting = stack[top - 1];
+            if (waiting->rightChild && waiting->rightChild != last) {
+                node = waiting->rightChild;
+            } else {
+                visitor(waiting);
+                last = waiting;
+                top--;
+            }
+        }
+    }
+}
+
+/**
+ * Reverse the right links on the path from a node to another, which ends the path
+ * @param {TreeNode *} from - first node, whose right link becomes NULL
+ * @param {TreeNode *} to - last node, whose right link must be NULL
+ * @return {void}
+ */
+void reverseHelper(TreeNode *from, TreeNode *to) {
+    TreeNode *previous = NULL, *node = from;
+    while (previous != to) {
+        TreeNode *next = node->rightChild;
+        node->rightChild = previous;
+        previous = node;
+        node = next;
+    }
+}
+
+/**
+ * Traverses a tree with Morris threading, i.e. without any stack. While it
+ * runs, right links of some nodes point back to their successors, so the
+ * visitor must neither follow nor change links
+ * @param {TreeNode *} root - root of the tree
+ * @param {TraversalOrder} traversalOrder - PRE_ORDER, IN_ORDER or POST_ORDER
+ * @param {void (*)(ElemType)} visitor - visit function
+ * @return {void}
+ */
+void morrisTraverse(TreeNode *root, TraversalOrder traversalOrder, void (*visitor)(TreeNode *)) {
+    TreeNode dummy; // post order visits right paths of left subtrees, the root being one
+    dummy.leftChild = root;
+    dummy.rightChild = NULL;
+    TreeNode *node = traversalOrder == POST_ORDER ? &dummy : root;
+    while (node) {
+        if (!node->leftChild) {
+            if (traversalOrder != POST_ORDER) {
+                visitor(node);
+            }
+            node = node->rightChild;
+            continue;
+        }
+        TreeNode *predecessor = node->leftChild;
+        while (predecessor->rightChild && predecessor->rightChild != node) {
+            predecessor = predecessor->rightChild;
         }
-        if (list[i]->rightChild) {
-            newList[newLength] = list[i]->rightChild;
-            newLength++;
+        if (!predecessor->rightChild) { // first time here, thread and go left
+            if (traversalOrder == PRE_ORDER) {
+                visitor(node);
+            }
+            predecessor->rightChild = node;
+            node = node->leftChild;
+            continue;
         }
+        predecessor->rightChild = NULL; // second time here, left subtree is done
+        if (traversalOrder == IN_ORDER) {
+            visitor(node);
+        } else if (traversalOrder == POST_ORDER) { // visit right path of left subtree bottom-up
+            reverseHelper(node->leftChild, predecessor);
+            for (TreeNode *path = predecessor;; path = path->rightChild) {
+                visitor(path);
+                if (path == node->leftChild) {
+                    break;
+                }
+            }
+            reverseHelper(predecessor, node->leftChild);
+        }
+        node = node->rightChild;
     }
-    levelOrderTraverse(newList, newLength, visitor);
 }
 
 /**
  * Traverse the binaryTree and print items
  * @param {BinaryTree *} binaryTree - pointer to binaryTree
- * @param {TraversalOrder} traversalOrder - traversal order
+ * @param {TraversalOrder} traversalOrder - traversal order, OR'ed with a traversal method
  * @param {void (*)(ElemType)} visitor - print function
  * @return {Status} - execution status
  */
@@ -98,72 +262,420 @@ Status binaryTreeTraverse(BinaryTree *binaryTree, TraversalOrder traversalOrder,
         return ERROR;
     }
     TreeNode *root = binaryTree->root;
-    switch (traversalOrder) {
-        case PRE_ORDER: // traverse pre-orderly
-            preOrderTraverse(root, visitor);
-            break;
-        case IN_ORDER: // traverse in-orderly
-            inOrderTraverse(root, visitor);
-            break;
-        case POST_ORDER: // traverse post-orderly
-            postOrderTraverse(root, visitor);
-            break;
-        case LEVEL_ORDER: // traverse level-orderly
-            levelOrderTraverse(&root, root ? 1 : 0, visitor);
-            break;
-        default:
-            return ERROR;
+    int method = traversalOrder & ~ORDER_MASK;
+    traversalOrder &= ORDER_MASK;
+    if (method != STACK_TRAVERSAL && method != MORRIS_TRAVERSAL && method != RECURSIVE_TRAVERSAL) {
+        return ERROR;
+    }
+    if (traversalOrder == LEVEL_ORDER || method == STACK_TRAVERSAL) {
+        if (stackReserve(binaryTree) != OK) {
+            return OVERFLOW;
+        }
+    }
+    if (traversalOrder == LEVEL_ORDER) { // traverse level-orderly
+        levelOrderTraverse(binaryTree, visitor, NULL);
+    } else if (method == MORRIS_TRAVERSAL) {
+        morrisTraverse(root, traversalOrder, visitor);
+    } else if (method == STACK_TRAVERSAL) {
+        stackTraverse(binaryTree, traversalOrder, visitor);
+    } else if (traversalOrder == PRE_ORDER) { // traverse pre-orderly
+        preOrderTraverse(root, visitor);
+    } else if (traversalOrder == IN_ORDER) { // traverse in-orderly
+        inOrderTraverse(root, visitor);
+    } else { // traverse post-orderly
+        postOrderTraverse(root, visitor);
     }
     return OK;
 }
 
 
 /**
- * Helper function to free node
+ * Allocate a block of nodes
+ * @param {int} capacity - number of nodes
+ * @return {TreeBlock *} - block with no node handed out, NULL if out of memory
+ */
+TreeBlock *blockCreate(int capacity) {
+    TreeBlock *block = (TreeBlock *) malloc(sizeof(TreeBlock) + sizeof(TreeNode) * capacity);
+    if (block) {
+        block->next = NULL;
+        block->capacity = capacity;
+        block->used = 0;
+    }
+    return block;
+}
+
+/**
+ * Allocate a node of a binaryTree, a released one if any
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @return {TreeNode *} - uninitialized node, NULL if out of memory
+ */
+TreeNode *allocateNode(BinaryTree *binaryTree) {
+    TreeNode *node = binaryTree->freeNodes;
+    if (node) {
+        binaryTree->freeNodes = node->leftChild;
+        binaryTree->freeCount--;
+        return node;
+    }
+    TreeBlock *block = binaryTree->blocks;
+    if (!block || block->used == block->capacity) { // blocks grow so that there are few of them
+        int capacity = block ? block->capacity * 2 : TREE_MIN_BLOCK;
+        capacity = capacity < TREE_MIN_BLOCK ? TREE_MIN_BLOCK : capacity > TREE_MAX_BLOCK ? TREE_MAX_BLOCK : capacity;
+        block = blockCreate(capacity);
+        if (!block) {
+            return NULL;
+        }
+        block->next = binaryTree->blocks;
+        binaryTree->blocks = block;
+    }
+    return &block->nodes[block->used++];
+}
+
+/**
+ * Release a node of a binaryTree for reuse
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode *} node - node no longer in the tree
+ * @return {void}
+ */
+void releaseNode(BinaryTree *binaryTree, TreeNode *node) {
+    node->leftChild = binaryTree->freeNodes;
+    node->rightChild = NULL;
+    binaryTree->freeNodes = node;
+    binaryTree->freeCount++;
+}
+
+/**
+ * Free a chain of node blocks
+ * @param {TreeBlock *} block - first block
+ * @return {void}
+ */
+void freeBlocks(TreeBlock *block) {
+    while (block) {
+        TreeBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+/**
+ * Hash a key into `bits` bits (Fibonacci hashing)
+ * @param {int} key - key
+ * @param {int} bits - log2 of capacity
+ * @return {uint32_t} - slot
+ */
+uint32_t indexHash(int key, int bits) {
+    return ((uint32_t) key * 2654435769u) >> (32 - bits);
+}
+
+/**
+ * Find the entry of a key
+ * @param {TreeIndex *} index - index
+ * @param {int} key - key
+ * @return {IndexEntry *} - entry, NULL if not found
+ */
+IndexEntry *indexFind(TreeIndex *index, int key) {
+    if (!index->size) {
+        return NULL;
+    }
+    uint32_t mask = (1u << index->bits) - 1;
+    for (uint32_t i = indexHash(key, index->bits);; i = (i + 1) & mask) {
+        IndexEntry *entry = &index->entries[i];
+        if (!entry->node) { // probing stops at an empty slot
+            return NULL;
+        }
+        if (entry->key == key) {
+            return entry;
+        }
+    }
+}
+
+/**
+ * Rehash an index into 2^bits slots
+ * @param {TreeIndex *} index - index
+ * @param {int} bits - log2 of new capacity
+ * @return {Status} - execution status
+ */
+Status indexResize(TreeIndex *index, int bits) {
+    IndexEntry *entries = (IndexEntry *) calloc((size_t) 1 << bits, sizeof(IndexEntry));
+    if (!entries) {
+        return OVERFLOW;
+    }
+    uint32_t mask = (1u << bits) - 1;
+    for (uint32_t i = 0; index->entries && i < 1u << index->bits; i++) {
+        IndexEntry *entry = &index->entries[i];
+        if (entry->node) {
+            uint32_t j = indexHash(entry->key, bits);
+            while (entries[j].node) {
+                j = (j + 1) & mask;
+            }
+            entries[j] = *entry;
+        }
+    }
+    free(index->entries);
+    index->entries = entries;
+    index->bits = bits;
+    return OK;
+}
+
+/**
+ * Insert a node into an index, keeping the load factor at most 1/2
+ * @param {TreeIndex *} index - index
+ * @param {int} key - key of node
  * @param {TreeNode *} node - node
+ * @param {TreeNode *} parent - parent of node, NULL for root, unused with TREE_PARENT_LINKS
+ * @return {Status} - execution status, ERROR if the key already exists
+ */
+Status indexInsert(TreeIndex *index, int key, TreeNode *node, TreeNode *parent) {
+    if (!index->entries || 2 * (index->size + 1) > 1 << index->bits) {
+        int bits = index->entries ? index->bits + 1 : INDEX_MIN_BITS;
+        if (bits > 30 || indexResize(index, bits) != OK) {
+            return OVERFLOW;
+        }
+    }
+    uint32_t mask = (1u << index->bits) - 1;
+    uint32_t i = indexHash(key, index->bits);
+    while (index->entries[i].node) {
+        if (index->entries[i].key == key) { // keys are unique
+            return ERROR;
+        }
+        i = (i + 1) & mask;
+    }
+    index->entries[i].key = key;
+    index->entries[i].node = node;
+#ifndef TREE_PARENT_LINKS
+    index->entries[i].parent = parent;
+#else
+    (void) parent; // nodes link to their parents themselves
+#endif
+    index->size++;
+    return OK;
+}
+
+/**
+ * Remove an entry from an index, shifting later entries of its cluster back
+ * so that no tombstone is needed
+ * @param {TreeIndex *} index - index
+ * @param {IndexEntry *} entry - entry
+ * @return {void}
+ */
+void indexRemove(TreeIndex *index, IndexEntry *entry) {
+    uint32_t mask = (1u << index->bits) - 1;
+    uint32_t hole = (uint32_t) (entry - index->entries);
+    for (uint32_t i = (hole + 1) & mask; index->entries[i].node; i = (i + 1) & mask) {
+        uint32_t home = indexHash(index->entries[i].key, index->bits);
+        // move back unless its home lies cyclically in (hole, i]
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            index->entries[hole] = index->entries[i];
+            hole = i;
+        }
+    }
+    index->entries[hole].node = NULL;
+    index->size--;
+}
+
+/**
+ * Free an index
+ * @param {TreeIndex *} index - index
  * @return {void}
  */
-void freeHelper(TreeNode *node) {
-    free(node);
+void indexClear(TreeIndex *index) {
+    free(index->entries);
+    index->entries = NULL;
+    index->bits = 0;
+    index->size = 0;
 }
 
 /**
- * Helper function to get index of item in array
- * @param {ElemType} item - item
- * @param {ElemType *} array - array of items
+ * Add all nodes of a subtree to an index, or remove them from it
+ * @param {TreeIndex *} index - index
+ * @param {TreeNode *} node - root of subtree
+ * @param {TreeNode *} parent - parent of `node`
+ * @param {Boolean} isAdd - add or remove
+ * @return {Status} - execution status, ERROR if a key to be added already exists
+ */
+Status indexSubtree(TreeIndex *index, TreeNode *node, TreeNode *parent, Boolean isAdd) {
+    if (!node) {
+        return OK;
+    }
+    // explicit stack of (node, parent) so that deep trees don't overflow the call stack
+    int capacity = 64, top = 0;
+    TreeNode **stack = (TreeNode **) malloc(sizeof(TreeNode *) * capacity * 2);
+    if (!stack) {
+        return OVERFLOW;
+    }
+    Status status = OK;
+    stack[top++] = node;
+    stack[top++] = parent;
+    while (top) {
+        parent = stack[--top];
+        node = stack[--top];
+        if (isAdd) {
+            Status result = indexInsert(index, node->data.key, node, parent);
+            if (result == OVERFLOW) {
+                status = OVERFLOW;
+                break;
+            }
+            if (result == ERROR) { // keep the first node of a duplicated key
+                status = ERROR;
+            }
+        } else {
+            IndexEntry *entry = indexFind(index, node->data.key);
+            if (entry && entry->node == node) {
+                indexRemove(index, entry);
+            }
+        }
+        if (top + 4 > capacity * 2) {
+            TreeNode **larger = (TreeNode **) realloc(stack, sizeof(TreeNode *) * capacity * 4);
+            if (!larger) {
+                status = OVERFLOW;
+                break;
+            }
+            stack = larger;
+            capacity *= 2;
+        }
+        if (node->rightChild) {
+            stack[top++] = node->rightChild;
+            stack[top++] = node;
+        }
+        if (node->leftChild) {
+            stack[top++] = node->leftChild;
+            stack[top++] = node;
+        }
+    }
+    free(stack);
+    return status;
+}
+
+/**
+ * Helper function to create tree in O(n) without recursion: nodes of the pre-order definition
+ * are pushed onto a stack, and popped when they come up in the in-order definition,
+ * a node hangs left of the stack top, or right of the last popped node
+ * @param {BinaryTree *} binaryTree - pointer to an empty binaryTree
+ * @param {ElemType *} preOrder - pre order definition
+ * @param {ElemType *} inOrder - in order definition
  * @param {int} length - list length
- * @return {int} - index
+ * @return {Status} - execution status, ERROR if definitions don't describe one tree of unique keys
  */
-int indexOf(ElemType item, ElemType *array, int length) {
-    for (int i = 0; i < length; i++) {
-        if (array[i].key == item.key) {
-            return i;
+Status createHelper(BinaryTree *binaryTree, ElemType *preOrder, ElemType *inOrder, int length) {
+    if (!length) { // empty tree
+        return OK;
+    }
+    TreeBlock *block = blockCreate(length);
+    TreeNode **stack = (TreeNode **) malloc(sizeof(TreeNode *) * length);
+    int bits = INDEX_MIN_BITS;
+    while (bits < 30 && 1 << bits < 2 * length) { // size the index once
+        bits++;
+    }
+    if (!block || !stack || indexResize(&binaryTree->index, bits) != OK) {
+        free(block);
+        free(stack);
+        return OVERFLOW;
+    }
+    TreeNode *nodes = block->nodes; // allocated in pre-order, i.e. in traversal order
+    Status status = OK;
+    int top = 0, j = 0;
+    for (int i = 0; i < length && status == OK; i++) {
+        TreeNode *node = &nodes[i];
+        node->data = preOrder[i];
+        node->leftChild = NULL;
+        node->rightChild = NULL;
+        TreeNode *parent = NULL;
+        while (top && stack[top - 1]->data.key == inOrder[j].key) { // left subtree of stack top is complete
+            parent = stack[--top];
+            j++;
         }
+        if (parent) {
+            parent->rightChild = node;
+        } else if (top) {
+            parent = stack[top - 1];
+            parent->leftChild = node;
+        }
+#ifdef TREE_PARENT_LINKS
+        node->parent = parent;
+#endif
+        status = indexInsert(&binaryTree->index, node->data.key, node, parent);
+        stack[top++] = node;
     }
-    return -1;
+    while (status == OK && top && j < length && stack[top - 1]->data.key == inOrder[j].key) {
+        top--;
+        j++;
+    }
+    free(stack);
+    if (status != OK || top || j != length) { // duplicated key or inconsistent definitions
+        free(block);
+        indexClear(&binaryTree->index);
+        return status == OVERFLOW ? OVERFLOW : ERROR;
+    }
+    block->used = length;
+    block->next = binaryTree->blocks;
+    binaryTree->blocks = block;
+    binaryTree->root = length ? &nodes[0] : NULL;
+    return OK;
 }
 
 /**
- * Helper function to create tree
- * @param {ElemType} item - item
- * @param {ElemType *} array - array of items
+ * Create a binaryTree from its pre order definition and the children each node has
+ * @param {BinaryTree *} binaryTree - empty binaryTree
+ * @param {ElemType *} preOrder - pre order definition
+ * @param {uint8_t *} children - CHILD_LEFT and CHILD_RIGHT bits of the i-th node at bit 2 * (i % 4) of byte i / 4
  * @param {int} length - list length
- * @return {TreeNode *}
+ * @return {Status} - execution status
  */
-TreeNode *createHelper(ElemType *preOrder, ElemType *inOrder, int index, int start, int end) {
-    int i = indexOf(preOrder[index], inOrder + start, end - start);
-    if (i < 0) {
-        return NULL;
-    } else {
-        i += start;
-    }
-    TreeNode *node = (TreeNode *) malloc(sizeof(TreeNode));
-    node->data.key = preOrder[index].key;
-    node->data.value = preOrder[index].value;
-    index += 1;
-    node->leftChild = createHelper(preOrder, inOrder, index, start, i);
-    node->rightChild = createHelper(preOrder, inOrder, index + i - start, i + 1, end);
-    return node;
+Status createShapeHelper(BinaryTree *binaryTree, ElemType *preOrder, uint8_t *children, int length) {
+    if (!length) { // empty tree
+        return OK;
+    }
+    TreeBlock *block = blockCreate(length);
+    TreeNode **stack = (TreeNode **) malloc(sizeof(TreeNode *) * length);
+    int bits = INDEX_MIN_BITS;
+    while (bits < 30 && 1 << bits < 2 * length) { // size the index once
+        bits++;
+    }
+    if (!block || !stack || indexResize(&binaryTree->index, bits) != OK) {
+        free(block);
+        free(stack);
+        return OVERFLOW;
+    }
+    TreeNode *nodes = block->nodes;
+    Status status = OK;
+    int top = 0; // nodes whose right child comes after their left subtree
+    Boolean hasLeft = FALSE; // the previous node has a left child, i.e. the current one
+    for (int i = 0; i < length && status == OK; i++) {
+        TreeNode *node = &nodes[i];
+        node->data = preOrder[i];
+        node->leftChild = NULL;
+        node->rightChild = NULL;
+        TreeNode *parent = NULL;
+        if (hasLeft) {
+            parent = &nodes[i - 1];
+            parent->leftChild = node;
+        } else if (top) {
+            parent = stack[--top];
+            parent->rightChild = node;
+        } else if (i) { // more nodes than the shape has room for
+            status = ERROR;
+            break;
+        }
+#ifdef TREE_PARENT_LINKS
+        node->parent = parent;
+#endif
+        status = indexInsert(&binaryTree->index, node->data.key, node, parent);
+        int child = children[i / 4] >> (i % 4 * 2);
+        if (child & CHILD_RIGHT) {
+            stack[top++] = node;
+        }
+        hasLeft = child & CHILD_LEFT;
+    }
+    free(stack);
+    if (status != OK || top || hasLeft) { // duplicated key or missing children
+        free(block);
+        indexClear(&binaryTree->index);
+        return status == OVERFLOW ? OVERFLOW : ERROR;
+    }
+    block->used = length;
+    block->next = binaryTree->blocks;
+    binaryTree->blocks = block;
+    binaryTree->root = &nodes[0];
+    return OK;
 }
 
 /**
@@ -201,12 +713,10 @@ Status createBinaryTree(BinaryTree *binaryTree, ElemType *preOrderDefinition, El
     if (!binaryTree->initialized) { // binaryTree doesn't exist
         return ERROR;
     }
-    if (binaryTree->root) {
+    if (binaryTree->root || binaryTree->ordered || length < 0) {
         return ERROR;
     }
-    int index = 0;
-    binaryTree->root = createHelper(preOrderDefinition, inOrderDefinition, index, 0, length);
-    return OK;
+    return createHelper(binaryTree, preOrderDefinition, inOrderDefinition, length);
 }
 
 /**
@@ -218,14 +728,16 @@ Status destroyBinaryTree(BinaryTree *binaryTree) {
     if (!binaryTree->initialized) { // binaryTree doesn't exist
         return ERROR;
     }
-    postOrderTraverse(binaryTree->root, freeHelper);
-    free(binaryTree->root);
+    clearBinaryTree(binaryTree);
+    free(binaryTree->stack);
+    binaryTree->stack = NULL;
+    binaryTree->stackSize = 0;
     binaryTree->initialized = FALSE;
     return OK;
 }
 
 /**
- * Clear an binaryTree
+ * Clear an binaryTree, which also leaves ordered mode
  * @param {BinaryTree *} binaryTree - pointer to a binaryTree
  * @return {Status} - execution status
  */
@@ -233,8 +745,70 @@ Status clearBinaryTree(BinaryTree *binaryTree) {
     if (!binaryTree->initialized) { // binaryTree doesn't exist
         return ERROR;
     }
-    postOrderTraverse(binaryTree->root, freeHelper);
+    freeBlocks(binaryTree->blocks); // nodes are released with their blocks
+    binaryTree->blocks = NULL;
+    binaryTree->freeNodes = NULL;
+    binaryTree->freeCount = 0;
     binaryTree->root = NULL;
+    binaryTree->ordered = FALSE; // so that createBinaryTree and loadData accept it again
+    indexClear(&binaryTree->index);
+    return OK;
+}
+
+/**
+ * Move all nodes of a binaryTree into one block in pre order, dropping released ones
+ * @param {BinaryTree *} binaryTree - pointer to a binaryTree
+ * @return {Status} - execution status
+ */
+Status compactBinaryTree(BinaryTree *binaryTree) {
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
+        return ERROR;
+    }
+    if (!binaryTree->root) { // only drop released nodes, an empty ordered binaryTree stays ordered
+        Boolean ordered = binaryTree->ordered;
+        clearBinaryTree(binaryTree);
+        binaryTree->ordered = ordered;
+        return OK;
+    }
+    int length = binaryTree->index.size;
+    TreeBlock *block = blockCreate(length);
+    if (!block || stackReserve(binaryTree) != OK) {
+        free(block);
+        return OVERFLOW;
+    }
+    TreeNode **stack = binaryTree->stack;
+    TreeNode *nodes = block->nodes;
+    int top = 0;
+    stack[top++] = binaryTree->root;
+    while (top) { // copy in pre order, leaving the new address in `leftChild` of the old node
+        TreeNode *node = stack[--top];
+        nodes[block->used] = *node;
+        node->leftChild = &nodes[block->used++];
+        if (node->rightChild) {
+            stack[top++] = node->rightChild;
+        }
+        if (nodes[block->used - 1].leftChild) {
+            stack[top++] = nodes[block->used - 1].leftChild;
+        }
+    }
+    for (int i = 0; i < length; i++) { // follow the new addresses
+        TreeNode *node = &nodes[i];
+        node->leftChild = node->leftChild ? node->leftChild->leftChild : NULL;
+        node->rightChild = node->rightChild ? node->rightChild->leftChild : NULL;
+#ifdef TREE_PARENT_LINKS
+        node->parent = node->parent ? node->parent->leftChild : NULL;
+#endif
+        IndexEntry *entry = indexFind(&binaryTree->index, node->data.key);
+        entry->node = node;
+#ifndef TREE_PARENT_LINKS
+        entry->parent = entry->parent ? entry->parent->leftChild : NULL;
+#endif
+    }
+    freeBlocks(binaryTree->blocks);
+    binaryTree->blocks = block;
+    binaryTree->root = &nodes[0];
+    binaryTree->freeNodes = NULL;
+    binaryTree->freeCount = 0;
     return OK;
 }
 
@@ -252,18 +826,29 @@ Boolean isBinaryTreeEmpty(BinaryTree *binaryTree) {
 }
 
 /**
- * Helper function to get depth
- * @param {TreeNode *} node - pointer to binaryTree
- * @param {int} depth - depth
+ * Helper function to get depth, which is the largest stack of a post order traversal
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
  * @return {int}
  */
-int getDepthHelper(TreeNode *node, int depth) {
-    if (node == NULL) {
-        return depth;
+int getDepthHelper(BinaryTree *binaryTree) {
+    if (stackReserve(binaryTree) != OK) {
+        return OVERFLOW;
     }
-    int left = getDepthHelper(node->leftChild, depth + 1);
-    int right = getDepthHelper(node->rightChild, depth + 1);
-    return left > right ? left : right;
+    TreeNode **stack = binaryTree->stack;
+    TreeNode *node = binaryTree->root, *last = NULL;
+    int top = 0, depth = 0;
+    while (node || top) {
+        if (node) { // all ancestors of a node are on the stack
+            stack[top++] = node;
+            depth = top > depth ? top : depth;
+            node = node->leftChild;
+        } else if (stack[top - 1]->rightChild && stack[top - 1]->rightChild != last) {
+            node = stack[top - 1]->rightChild;
+        } else {
+            last = stack[--top];
+        }
+    }
+    return depth;
 }
 
 /**
@@ -275,7 +860,7 @@ int binaryTreeDepth(BinaryTree *binaryTree) {
     if (!binaryTree->initialized) { // binaryTree doesn't exist
         return ERROR;
     }
-    return getDepthHelper(binaryTree->root, 0);
+    return getDepthHelper(binaryTree);
 }
 
 /**
@@ -292,20 +877,34 @@ TreeNode *getRoot(BinaryTree *binaryTree) {
 }
 
 /**
- * Helper function to get parent
- * @param {TreeNode *} node - pointer to binaryTree
- * @param {int} key - key
- * @return {TreeNode *}
+ * Get parent of a known node in O(1), from its link or from the index
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode *} node - node of the binaryTree
+ * @return {TreeNode *} - pointer to parent, NULL for root
  */
-TreeNode *getParentHelper(TreeNode *node, int key) {
-    if (node == NULL || (node->leftChild && node->leftChild->data.key == key) || (node->rightChild && node->rightChild->data.key == key)) {
-        return node;
-    }
-    TreeNode *parent = getParentHelper(node->leftChild, key);
-    if (parent == NULL) {
-        parent = getParentHelper(node->rightChild, key);
-    }
-    return parent;
+TreeNode *parentOf(BinaryTree *binaryTree, TreeNode *node) {
+#ifdef TREE_PARENT_LINKS
+    (void) binaryTree;
+    return node->parent;
+#else
+    return indexFind(&binaryTree->index, node->data.key)->parent;
+#endif
+}
+
+/**
+ * Set parent of a known node
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode *} node - node of the binaryTree
+ * @param {TreeNode *} parent - new parent
+ * @return {void}
+ */
+void setParent(BinaryTree *binaryTree, TreeNode *node, TreeNode *parent) {
+#ifdef TREE_PARENT_LINKS
+    (void) binaryTree;
+    node->parent = parent;
+#else
+    indexFind(&binaryTree->index, node->data.key)->parent = parent;
+#endif
 }
 
 /**
@@ -315,10 +914,47 @@ TreeNode *getParentHelper(TreeNode *node, int key) {
  * @return {TreeNode *} - pointer to parent
  */
 TreeNode *getParent(BinaryTree *binaryTree, int key) {
-    if (!binaryTree->initialized || !binaryTree->root || binaryTree->root->data.key == key) { // binaryTree doesn't exist
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
         return NULL;
     }
-    return getParentHelper(binaryTree->root, key);
+    TreeNode *node = getNode(binaryTree, key);
+    return node ? parentOf(binaryTree, node) : NULL;
+}
+
+/**
+ * Get ancestors of a node by walking up in O(depth)
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {int} key - key
+ * @param {TreeNode **} ancestors - filled with parent, grandparent, ..., root if not NULL
+ * @return {int} - number of ancestors, ERROR if the node doesn't exist
+ */
+int getAncestors(BinaryTree *binaryTree, int key, TreeNode **ancestors) {
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
+        return ERROR;
+    }
+    TreeNode *node = getNode(binaryTree, key);
+    if (!node) {
+        return ERROR;
+    }
+    int count = 0;
+    while ((node = parentOf(binaryTree, node))) {
+        if (ancestors) {
+            ancestors[count] = node;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Get depth of a node, 1 for root
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {int} key - key
+ * @return {int} - depth, ERROR if the node doesn't exist
+ */
+int nodeDepth(BinaryTree *binaryTree, int key) {
+    int count = getAncestors(binaryTree, key, NULL);
+    return count == ERROR ? ERROR : count + 1;
 }
 
 /**
@@ -332,18 +968,8 @@ TreeNode *getNode(BinaryTree *binaryTree, int key) {
         return NULL;
     }
 
-    if (binaryTree->root && binaryTree->root->data.key == key) {
-        return binaryTree->root;
-    }
-    TreeNode *parent = getParent(binaryTree, key);
-    if (parent == NULL) {
-        return NULL;
-    }
-    if (parent->leftChild && parent->leftChild->data.key == key) {
-        return parent->leftChild;
-    } else {
-        return parent->rightChild;
-    }
+    IndexEntry *entry = indexFind(&binaryTree->index, key);
+    return entry ? entry->node : NULL;
 }
 
 /**
@@ -430,16 +1056,13 @@ TreeNode *getLeftSibling(BinaryTree *binaryTree, int key) {
         return NULL;
     }
 
-    TreeNode *parent = getParent(binaryTree, key);
+    TreeNode *node = getNode(binaryTree, key);
+    TreeNode *parent = node ? parentOf(binaryTree, node) : NULL;
     if (!parent) {
         return NULL;
     }
     TreeNode *left = parent->leftChild;
-
-    if (!left) {
-        return NULL;
-    }
-    return left->data.key != key ? left : NULL;
+    return left != node ? left : NULL;
 }
 
 /**
@@ -453,16 +1076,13 @@ TreeNode *getRightSibling(BinaryTree *binaryTree, int key) {
         return NULL;
     }
 
-    TreeNode *parent = getParent(binaryTree, key);
+    TreeNode *node = getNode(binaryTree, key);
+    TreeNode *parent = node ? parentOf(binaryTree, node) : NULL;
     if (!parent) {
         return NULL;
     }
     TreeNode *right = parent->rightChild;
-
-    if (!right) {
-        return NULL;
-    }
-    return right->data.key != key ? right : NULL;
+    return right != node ? right : NULL;
 }
 
 /**
@@ -477,22 +1097,73 @@ Status insertSubtree(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft, Bin
     if (!binaryTree->initialized || !newTree->initialized || !node) { // binaryTree doesn't exist
         return ERROR;
     }
+    if (binaryTree->ordered) { // would break the order, use orderedInsert
+        return ERROR;
+    }
 
     TreeNode *root = newTree->root;
-    free(newTree);
-
-    if (root->rightChild) {
+    if (!root || root->rightChild) {
         return ERROR;
     }
-
-    if (isLeft) {
-        root->rightChild = node->leftChild;
-        node->leftChild = root;
-    } else {
-        root->rightChild = node->rightChild;
-        node->rightChild = root;
+    TreeIndex *index = &newTree->index;
+    for (uint32_t i = 0; i < 1u << index->bits; i++) { // keys must stay unique
+        if (index->entries[i].node && indexFind(&binaryTree->index, index->entries[i].key)) {
+            return ERROR;
+        }
     }
-    return OK;
+    // size the index for both trees first, so that moving entries can't fail halfway
+    long long size = (long long) binaryTree->index.size + index->size;
+    int bits = binaryTree->index.entries ? binaryTree->index.bits : INDEX_MIN_BITS;
+    while (bits < 30 && 1LL << bits < 2 * size) {
+        bits++;
+    }
+    if (1LL << bits < 2 * size) {
+        return OVERFLOW;
+    }
+    if ((!binaryTree->index.entries || bits > binaryTree->index.bits)
+        && indexResize(&binaryTree->index, bits) != OK) {
+        return OVERFLOW;
+    }
+    for (uint32_t i = 0; i < 1u << index->bits; i++) { // move entries of `newTree`
+        IndexEntry *entry = &index->entries[i];
+        if (entry->node) {
+            indexInsert(&binaryTree->index, entry->key, entry->node,
+                        entry->node == root ? node : parentOf(newTree, entry->node));
+        }
+    }
+    setParent(binaryTree, root, node);
+    indexClear(index);
+    if (newTree->blocks) { // nodes of `newTree` now belong to `binaryTree`
+        TreeBlock *last = newTree->blocks;
+        while (last->next) {
+            last = last->next;
+        }
+        last->next = binaryTree->blocks;
+        binaryTree->blocks = newTree->blocks;
+    }
+    if (newTree->freeNodes) { // and so do its released nodes
+        TreeNode *last = newTree->freeNodes;
+        while (last->leftChild) {
+            last = last->leftChild;
+        }
+        last->leftChild = binaryTree->freeNodes;
+        binaryTree->freeNodes = newTree->freeNodes;
+        binaryTree->freeCount += newTree->freeCount;
+    }
+    free(newTree->stack);
+    free(newTree);
+
+    if (isLeft) {
+        root->rightChild = node->leftChild;
+        node->leftChild = root;
+    } else {
+        root->rightChild = node->rightChild;
+        node->rightChild = root;
+    }
+    if (root->rightChild) { // the old child now hangs under `root`
+        setParent(binaryTree, root->rightChild, root);
+    }
+    return OK;
 }
 
 /**
@@ -507,9 +1178,32 @@ Status deleteSubtree(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft) {
     if (!binaryTree->initialized || !node) { // binaryTree doesn't exist
         return ERROR;
     }
+    if (binaryTree->ordered) { // would break the balance, use orderedDelete
+        return ERROR;
+    }
 
     TreeNode *subTree = isLeft ? node->leftChild : node->rightChild;
-    postOrderTraverse(subTree, freeHelper);
+    if (subTree && stackReserve(binaryTree) == OK) { // release nodes for reuse
+        TreeNode **stack = binaryTree->stack;
+        int top = 0;
+        stack[top++] = subTree;
+        while (top) {
+            TreeNode *child = stack[--top];
+            if (child->rightChild) {
+                stack[top++] = child->rightChild;
+            }
+            if (child->leftChild) {
+                stack[top++] = child->leftChild;
+            }
+            IndexEntry *entry = indexFind(&binaryTree->index, child->data.key);
+            if (entry && entry->node == child) {
+                indexRemove(&binaryTree->index, entry);
+            }
+            releaseNode(binaryTree, child);
+        }
+    } else { // nodes stay in their block until the tree is cleared
+        indexSubtree(&binaryTree->index, subTree, node, FALSE);
+    }
     if (isLeft) {
         node->leftChild = NULL;
     } else {
@@ -518,6 +1212,330 @@ Status deleteSubtree(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft) {
     return OK;
 }
 
+/**
+ * Height of a subtree in ordered mode
+ * @param {TreeNode *} node - root of the subtree
+ * @return {int} - 0 for an empty subtree
+ */
+int heightOf(TreeNode *node) {
+    return node ? node->height : 0;
+}
+
+/**
+ * Recompute the height of a node from its children
+ * @param {TreeNode *} node - node
+ * @return {void}
+ */
+void updateHeight(TreeNode *node) {
+    int left = heightOf(node->leftChild), right = heightOf(node->rightChild);
+    node->height = 1 + (left > right ? left : right);
+}
+
+/**
+ * Rotate a subtree, the caller links the new root to the parent of `node`
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode *} node - root of the subtree
+ * @param {Boolean} isLeft - rotate left, i.e. the right child becomes the root
+ * @return {TreeNode *} - new root of the subtree
+ */
+TreeNode *rotateHelper(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft) {
+    TreeNode *child = isLeft ? node->rightChild : node->leftChild;
+    TreeNode *middle = isLeft ? child->leftChild : child->rightChild; // changes sides
+    if (isLeft) {
+        node->rightChild = middle;
+        child->leftChild = node;
+    } else {
+        node->leftChild = middle;
+        child->rightChild = node;
+    }
+    if (middle) {
+        setParent(binaryTree, middle, node);
+    }
+    setParent(binaryTree, node, child);
+    updateHeight(node);
+    updateHeight(child);
+    return child;
+}
+
+/**
+ * Restore the AVL balance of a subtree whose children are balanced
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode *} node - root of the subtree
+ * @return {TreeNode *} - new root of the subtree
+ */
+TreeNode *balanceHelper(BinaryTree *binaryTree, TreeNode *node) {
+    int balance = heightOf(node->leftChild) - heightOf(node->rightChild);
+    if (balance > 1) { // left heavy
+        TreeNode *left = node->leftChild;
+        if (heightOf(left->leftChild) < heightOf(left->rightChild)) { // left-right case
+            node->leftChild = rotateHelper(binaryTree, left, TRUE);
+            setParent(binaryTree, node->leftChild, node);
+        }
+        return rotateHelper(binaryTree, node, FALSE);
+    }
+    if (balance < -1) { // right heavy
+        TreeNode *right = node->rightChild;
+        if (heightOf(right->rightChild) < heightOf(right->leftChild)) { // right-left case
+            node->rightChild = rotateHelper(binaryTree, right, FALSE);
+            setParent(binaryTree, node->rightChild, node);
+        }
+        return rotateHelper(binaryTree, node, TRUE);
+    }
+    updateHeight(node);
+    return node;
+}
+
+/**
+ * Rebalance the nodes on a path from the root after an insertion or deletion below it
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode **} path - nodes from the root downwards
+ * @param {int} length - number of nodes on the path
+ * @return {void}
+ */
+void rebalanceHelper(BinaryTree *binaryTree, TreeNode **path, int length) {
+    for (int i = length - 1; i >= 0; i--) {
+        TreeNode *node = path[i];
+        TreeNode *root = balanceHelper(binaryTree, node);
+        if (root == node) {
+            continue;
+        }
+        TreeNode *parent = i ? path[i - 1] : NULL;
+        if (!parent) {
+            binaryTree->root = root;
+        } else if (parent->leftChild == node) {
+            parent->leftChild = root;
+        } else {
+            parent->rightChild = root;
+        }
+        setParent(binaryTree, root, parent);
+    }
+}
+
+/**
+ * Compare the keys of two nodes, for qsort
+ * @param {const void *} a - pointer to `TreeNode *`
+ * @param {const void *} b - pointer to `TreeNode *`
+ * @return {int}
+ */
+int keyCompareHelper(const void *a, const void *b) {
+    int x = (*(TreeNode **) a)->data.key, y = (*(TreeNode **) b)->data.key;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Helper function to link sorted nodes into a balanced tree
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {TreeNode **} nodes - nodes sorted by key
+ * @param {int} length - number of nodes
+ * @param {TreeNode *} parent - parent of the subtree
+ * @return {TreeNode *} - root of the subtree
+ */
+TreeNode *orderHelper(BinaryTree *binaryTree, TreeNode **nodes, int length, TreeNode *parent) {
+    if (length <= 0) {
+        return NULL;
+    }
+    int middle = length / 2;
+    TreeNode *node = nodes[middle];
+    setParent(binaryTree, node, parent);
+    node->leftChild = orderHelper(binaryTree, nodes, middle, node); // depth is log2(length)
+    node->rightChild = orderHelper(binaryTree, nodes + middle + 1, length - middle - 1, node);
+    updateHeight(node);
+    return node;
+}
+
+/**
+ * Switch a binaryTree to ordered mode, relinking its nodes into a balanced search tree
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @return {Status} - execution status
+ */
+Status orderBinaryTree(BinaryTree *binaryTree) {
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
+        return ERROR;
+    }
+    int length = binaryTree->index.size;
+    TreeNode **nodes = (TreeNode **) malloc(sizeof(TreeNode *) * (length ? length : 1));
+    if (!nodes || stackReserve(binaryTree) != OK) {
+        free(nodes);
+        return OVERFLOW;
+    }
+    TreeNode **stack = binaryTree->stack;
+    TreeNode *node = binaryTree->root;
+    int top = 0, count = 0;
+    Boolean sorted = TRUE;
+    while (node || top) { // collect in order
+        if (node) {
+            stack[top++] = node;
+            node = node->leftChild;
+        } else {
+            node = stack[--top];
+            sorted = sorted && (!count || nodes[count - 1]->data.key < node->data.key);
+            nodes[count++] = node;
+            node = node->rightChild;
+        }
+    }
+    if (!sorted) {
+        qsort(nodes, length, sizeof(TreeNode *), keyCompareHelper);
+    }
+    binaryTree->root = orderHelper(binaryTree, nodes, length, NULL);
+    binaryTree->ordered = TRUE;
+    free(nodes);
+    return OK;
+}
+
+/**
+ * Insert an element into an ordered binaryTree, or replace the value of its key
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {ElemType} e - element
+ * @return {Status} - execution status
+ */
+Status orderedInsert(BinaryTree *binaryTree, ElemType e) {
+    if (!binaryTree->initialized || !binaryTree->ordered) { // binaryTree doesn't exist or isn't ordered
+        return ERROR;
+    }
+    if (stackReserve(binaryTree) != OK) {
+        return OVERFLOW;
+    }
+    TreeNode **path = binaryTree->stack;
+    TreeNode *node = binaryTree->root;
+    int top = 0;
+    while (node) {
+        if (node->data.key == e.key) {
+            node->data.value = e.value;
+            return OK;
+        }
+        path[top++] = node;
+        node = e.key < node->data.key ? node->leftChild : node->rightChild;
+    }
+    TreeNode *parent = top ? path[top - 1] : NULL;
+    node = allocateNode(binaryTree);
+    if (!node || indexInsert(&binaryTree->index, e.key, node, parent) != OK) {
+        if (node) {
+            releaseNode(binaryTree, node);
+        }
+        return OVERFLOW;
+    }
+    node->data = e;
+    node->height = 1;
+    node->leftChild = NULL;
+    node->rightChild = NULL;
+#ifdef TREE_PARENT_LINKS
+    node->parent = parent;
+#endif
+    if (!parent) {
+        binaryTree->root = node;
+    } else if (e.key < parent->data.key) {
+        parent->leftChild = node;
+    } else {
+        parent->rightChild = node;
+    }
+    rebalanceHelper(binaryTree, path, top);
+    return OK;
+}
+
+/**
+ * Delete the element of a key from an ordered binaryTree. A node with two children
+ * takes over the element of its successor, whose node is released instead
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {int} key - key
+ * @return {Status} - execution status
+ */
+Status orderedDelete(BinaryTree *binaryTree, int key) {
+    if (!binaryTree->initialized || !binaryTree->ordered) { // binaryTree doesn't exist or isn't ordered
+        return ERROR;
+    }
+    if (stackReserve(binaryTree) != OK) {
+        return OVERFLOW;
+    }
+    TreeNode **path = binaryTree->stack;
+    TreeNode *node = binaryTree->root;
+    int top = 0;
+    while (node && node->data.key != key) {
+        path[top++] = node;
+        node = key < node->data.key ? node->leftChild : node->rightChild;
+    }
+    if (!node) { // key doesn't exist
+        return ERROR;
+    }
+    indexRemove(&binaryTree->index, indexFind(&binaryTree->index, key));
+    TreeNode *removed = node;
+    if (node->leftChild && node->rightChild) { // successor is the leftmost node of the right subtree
+        TreeNode *parent = top ? path[top - 1] : NULL;
+        path[top++] = node;
+        removed = node->rightChild;
+        while (removed->leftChild) {
+            path[top++] = removed;
+            removed = removed->leftChild;
+        }
+        node->data = removed->data;
+        IndexEntry *entry = indexFind(&binaryTree->index, node->data.key);
+        entry->node = node;
+#ifndef TREE_PARENT_LINKS
+        entry->parent = parent;
+#else
+        (void) parent;
+#endif
+    }
+    TreeNode *parent = top ? path[top - 1] : NULL;
+    TreeNode *child = removed->leftChild ? removed->leftChild : removed->rightChild;
+    if (!parent) {
+        binaryTree->root = child;
+    } else if (parent->leftChild == removed) {
+        parent->leftChild = child;
+    } else {
+        parent->rightChild = child;
+    }
+    if (child) {
+        setParent(binaryTree, child, parent);
+    }
+    releaseNode(binaryTree, removed);
+    rebalanceHelper(binaryTree, path, top);
+    return OK;
+}
+
+/**
+ * Find the first node of an ordered binaryTree whose key is not less than a key
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {int} key - key
+ * @return {TreeNode *} - NULL if there is none
+ */
+TreeNode *lowerBound(BinaryTree *binaryTree, int key) {
+    if (!binaryTree->initialized || !binaryTree->ordered) { // binaryTree doesn't exist or isn't ordered
+        return NULL;
+    }
+    TreeNode *node = binaryTree->root, *bound = NULL;
+    while (node) {
+        if (node->data.key >= key) {
+            bound = node;
+            node = node->leftChild;
+        } else {
+            node = node->rightChild;
+        }
+    }
+    return bound;
+}
+
+/**
+ * Find the first node of an ordered binaryTree whose key is greater than a key
+ * @param {BinaryTree *} binaryTree - pointer to binaryTree
+ * @param {int} key - key
+ * @return {TreeNode *} - NULL if there is none
+ */
+TreeNode *upperBound(BinaryTree *binaryTree, int key) {
+    if (!binaryTree->initialized || !binaryTree->ordered) { // binaryTree doesn't exist or isn't ordered
+        return NULL;
+    }
+    TreeNode *node = binaryTree->root, *bound = NULL;
+    while (node) {
+        if (node->data.key > key) {
+            bound = node;
+            node = node->leftChild;
+        } else {
+            node = node->rightChild;
+        }
+    }
+    return bound;
+}
+
 /**
  * Select a binaryTree
  * @param {BinaryTree **} currentBinaryTree - pointer to `BinaryTree *currentBinaryTree`
@@ -530,32 +1548,172 @@ Status selectBinaryTree(BinaryTree **currentBinaryTree, BinaryTree *nextBinaryTr
 }
 
 /**
- * Helper function to load data
+ * Helper function to parse the text data file in blocks in a single pass
+ * @param {FILE *} fp - file pointer
+ * @param {ElemType **} elements - output, pre order followed by in order elements
+ * @param {int *} count - output, number of elements
+ * @return {Status} - execution status
+ */
+Status parseHelper(FILE *fp, ElemType **elements, int *count) {
+    char *buffer = (char *) malloc(FILE_BLOCK);
+    int capacity = 1024;
+    ElemType *list = (ElemType *) malloc(sizeof(ElemType) * capacity);
+    if (!buffer || !list) {
+        free(buffer);
+        free(list);
+        return OVERFLOW;
+    }
+    int length = 0, field = 0; // field 0 is key, 1 is value
+    long long number = 0;
+    int digits = 0;
+    Boolean negative = FALSE;
+    Status status = OK;
+    size_t size;
+    do {
+        size = fread(buffer, 1, FILE_BLOCK, fp);
+        for (size_t i = 0; i <= size && status == OK; i++) {
+            // a number may continue in the next block, so only flush at a separator or end of file
+            int c = i < size ? (unsigned char) buffer[i] : (size < FILE_BLOCK ? ' ' : EOF);
+            if (c >= '0' && c <= '9') {
+                number = number * 10 + (c - '0');
+                if (number > (long long) INT32_MAX + 1) { // out of range of int
+                    status = ERROR;
+                }
+                digits++;
+            } else if (c == '-' && !digits && !negative) {
+                negative = TRUE;
+            } else if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                if (!digits) {
+                    if (negative) { // lonely minus sign
+                        status = ERROR;
+                    }
+                    continue;
+                }
+                if (!negative && number > INT32_MAX) {
+                    status = ERROR;
+                    break;
+                }
+                if (length == capacity) { // grow by doubling
+                    if (capacity > INT32_MAX / 2) {
+                        status = OVERFLOW;
+                        break;
+                    }
+                    ElemType *larger = (ElemType *) realloc(list, sizeof(ElemType) * capacity * 2);
+                    if (!larger) {
+                        status = OVERFLOW;
+                        break;
+                    }
+                    list = larger;
+                    capacity *= 2;
+                }
+                int parsed = (int) (negative ? -number : number);
+                if (field == 0) {
+                    list[length].key = parsed;
+                } else {
+                    list[length++].value = parsed;
+                }
+                field ^= 1;
+                number = 0;
+                digits = 0;
+                negative = FALSE;
+            } else if (c != EOF) { // invalid character
+                status = ERROR;
+            }
+        }
+    } while (size == FILE_BLOCK && status == OK);
+    free(buffer);
+    if (status == OK && (field || ferror(fp))) { // key without value or read error
+        status = ERROR;
+    }
+    if (status != OK) {
+        free(list);
+        return status;
+    }
+    *elements = list;
+    *count = length;
+    return OK;
+}
+
+/**
+ * Helper function to load a binary data file after its magic number
  * @param {BinaryTree *} binaryTree - binaryTree
  * @param {FILE *} fp - file pointer
  * @return {Status} - execution status
  */
-Status loadHelper(BinaryTree *binaryTree, FILE* fp) {
-    int key, value;
-    /* fscanf: read as ascii */
-    int length = 0;
-    while (fscanf(fp, "%d %d\n", &key, &value) != EOF) { // while element value exists
-        length++;
+Status loadBinaryHelper(BinaryTree *binaryTree, FILE *fp) {
+    FileHeader header;
+    if (fread(&header.version, sizeof(header) - sizeof(header.magic), 1, fp) != 1) {
+        return ERROR;
+    }
+    if ((header.version != BINARY_FORMAT && header.version != COMPACT_FORMAT) || header.length > INT32_MAX / 2) {
+        return ERROR;
     }
+    int length = (int) header.length; // no counting needed
     if (length == 0) {
         printf("There are no data!\n");
-        fclose(fp);
         return ERROR;
     }
-    length /= 2;
-    rewind(fp);
-
-    ElemType *preOrder = scanHelper(length, fp);
-    ElemType *inOrder = scanHelper(length, fp);
+    Boolean isCompact = header.version == COMPACT_FORMAT;
+    size_t count = isCompact ? (size_t) length : (size_t) length * 2;
+    size_t bytes = isCompact ? (size_t) (length + 3) / 4 : 0;
+    ElemType *elements = (ElemType *) malloc(sizeof(ElemType) * count);
+    uint8_t *children = (uint8_t *) malloc(bytes ? bytes : 1);
+    if (!elements || !children) {
+        free(elements);
+        free(children);
+        return OVERFLOW;
+    }
+    Status status = ERROR;
+    if (fread(elements, sizeof(ElemType), count, fp) == count && fread(children, 1, bytes, fp) == bytes
+        && fgetc(fp) == EOF) { // neither truncated nor with trailing data
+        if (isCompact) {
+            status = createShapeHelper(binaryTree, elements, children, length);
+        } else {
+            status = createBinaryTree(binaryTree, elements, elements + length, length);
+        }
+    }
+    free(elements);
+    free(children);
+    return status;
+}
 
+/**
+ * Helper function to load data
+ * @param {BinaryTree *} binaryTree - binaryTree
+ * @param {FILE *} fp - file pointer
+ * @return {Status} - execution status
+ */
+Status loadHelper(BinaryTree *binaryTree, FILE* fp) {
+    ElemType *elements = NULL;
+    int count = 0;
+    char magic[sizeof(FILE_MAGIC) - 1];
+    Status status;
+    if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) && !memcmp(magic, FILE_MAGIC, sizeof(magic))) {
+        status = loadBinaryHelper(binaryTree, fp);
+        fclose(fp);
+        return status;
+    }
+    rewind(fp);
+    status = parseHelper(fp, &elements, &count);
     fclose(fp);
-
-    return createBinaryTree(binaryTree, preOrder, inOrder, length);
+    if (status != OK) {
+        printf("Invalid data!\n");
+        return status;
+    }
+    if (count == 0) {
+        printf("There are no data!\n");
+        free(elements);
+        return ERROR;
+    }
+    if (count % 2) { // pre order and in order definitions must be of the same length
+        printf("Invalid data!\n");
+        free(elements);
+        return ERROR;
+    }
+    int length = count / 2;
+    status = createBinaryTree(binaryTree, elements, elements + length, length);
+    free(elements);
+    return status;
 }
 
 /**
@@ -564,7 +1722,7 @@ Status loadHelper(BinaryTree *binaryTree, FILE* fp) {
  * @return {Status} - execution status
  */
 Status loadData(BinaryTree *binaryTree) {
-    FILE *fp = fopen("data.txt", "r");
+    FILE *fp = fopen(FILE_NAME, "rb");
     if (fp == NULL) { // file doesn't exist
         printf("File doesn't exist!\n");
         return ERROR;
@@ -584,36 +1742,382 @@ Status loadData(BinaryTree *binaryTree) {
 }
 
 /**
- * Helper function to save data
- * @param {TreeNode *} node - node
+ * Write the buffered bytes to the file
+ * @param {FileBuffer *} file - buffered file
  * @return {void}
  */
-void saveHelper(TreeNode *node) {
-    FILE *fp = fopen("data.txt", "a");
-    fprintf(fp, "%d %d\n", node->data.key, node->data.value);
-    fclose(fp);
+void flushHelper(FileBuffer *file) {
+    if (file->size && fwrite(file->data, 1, file->size, file->fp) != file->size) {
+        file->status = ERROR;
+    }
+    file->size = 0;
+}
+
+/**
+ * Append bytes to a buffered file
+ * @param {FileBuffer *} file - buffered file
+ * @param {const void *} data - bytes
+ * @param {size_t} size - number of bytes
+ * @return {void}
+ */
+void writeHelper(FileBuffer *file, const void *data, size_t size) {
+    if (file->size + size > FILE_BLOCK) {
+        flushHelper(file);
+    }
+    if (size > FILE_BLOCK) { // too large to buffer
+        if (fwrite(data, 1, size, file->fp) != size) {
+            file->status = ERROR;
+        }
+        return;
+    }
+    memcpy(file->data + file->size, data, size);
+    file->size += size;
 }
 
 /**
- * Save data to a file
+ * Append an element as a `key value` line to a buffered file
+ * @param {FileBuffer *} file - buffered file
+ * @param {ElemType} e - element
+ * @return {void}
+ */
+void formatHelper(FileBuffer *file, ElemType e) {
+    char line[24];
+    int numbers[] = {e.key, e.value};
+    int size = 0;
+    for (int i = 0; i < 2; i++) {
+        uint32_t number = numbers[i] < 0 ? 0u - (uint32_t) numbers[i] : (uint32_t) numbers[i];
+        char digits[10];
+        int count = 0;
+        do { // digits in reverse order
+            digits[count++] = (char) ('0' + number % 10);
+            number /= 10;
+        } while (number);
+        if (numbers[i] < 0) {
+            line[size++] = '-';
+        }
+        while (count) {
+            line[size++] = digits[--count];
+        }
+        line[size++] = i ? '\n' : ' ';
+    }
+    writeHelper(file, line, size);
+}
+
+/**
+ * Helper function to save data, visiting every node once
  * @param {BinaryTree *} binaryTree - binaryTree
+ * @param {FILE *} fp - file pointer
+ * @param {FileFormat} format - TEXT_FORMAT, BINARY_FORMAT or COMPACT_FORMAT
  * @return {Status} - execution status
  */
-Status saveData(BinaryTree *binaryTree) {
+Status saveHelper(BinaryTree *binaryTree, FILE *fp, FileFormat format) {
+    int length = binaryTree->index.size;
+    FileBuffer file = {fp, (char *) malloc(FILE_BLOCK), 0, OK};
+    // in order definition follows the pre order one, the children bits follow the elements
+    ElemType *inOrder = format == COMPACT_FORMAT ? NULL : (ElemType *) malloc(sizeof(ElemType) * (length ? length : 1));
+    uint8_t *children = format == COMPACT_FORMAT ? (uint8_t *) calloc((length + 3) / 4 + 1, 1) : NULL;
+    if (!file.data || stackReserve(binaryTree) != OK || (format == COMPACT_FORMAT ? !children : !inOrder)) {
+        free(file.data);
+        free(inOrder);
+        free(children);
+        return OVERFLOW;
+    }
+    if (format != TEXT_FORMAT) {
+        FileHeader header;
+        memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.version = (uint32_t) format;
+        header.length = (uint32_t) length;
+        writeHelper(&file, &header, sizeof(header));
+    }
+    TreeNode **stack = binaryTree->stack;
+    TreeNode *node = binaryTree->root;
+    int top = 0, i = 0, j = 0;
+    while (node || top) { // pre order on the way down, in order on the way up
+        while (node) {
+            if (format == TEXT_FORMAT) {
+                formatHelper(&file, node->data);
+            } else {
+                writeHelper(&file, &node->data, sizeof(ElemType));
+            }
+            if (children) {
+                int child = (node->leftChild ? CHILD_LEFT : 0) | (node->rightChild ? CHILD_RIGHT : 0);
+                children[i / 4] |= (uint8_t) (child << (i % 4 * 2));
+            }
+            i++;
+            stack[top++] = node;
+            node = node->leftChild;
+        }
+        node = stack[--top];
+        if (inOrder) {
+            inOrder[j++] = node->data;
+        }
+        node = node->rightChild;
+    }
+    if (format == TEXT_FORMAT) {
+        writeHelper(&file, "\n", 1);
+        for (j = 0; j < length; j++) {
+            formatHelper(&file, inOrder[j]);
+        }
+    } else if (format == BINARY_FORMAT) {
+        writeHelper(&file, inOrder, sizeof(ElemType) * length);
+    } else {
+        writeHelper(&file, children, (length + 3) / 4);
+    }
+    flushHelper(&file);
+    free(file.data);
+    free(inOrder);
+    free(children);
+    return file.status;
+}
+
+/**
+ * Save data to a file, which is replaced only after being completely written
+ * @param {BinaryTree *} binaryTree - binaryTree
+ * @param {FileFormat} format - TEXT_FORMAT, BINARY_FORMAT or COMPACT_FORMAT
+ * @return {Status} - execution status
+ */
+Status saveData(BinaryTree *binaryTree, FileFormat format) {
     if (!binaryTree->initialized) { // binaryTree doesn't exist
         return ERROR;
     }
+    if (format != TEXT_FORMAT && format != BINARY_FORMAT && format != COMPACT_FORMAT) {
+        return ERROR;
+    }
 
-    FILE *fp = fopen("data.txt", "w+");
-    fclose(fp);
-    preOrderTraverse(binaryTree->root, saveHelper);
-    fp = fopen("data.txt", "a");
-    fprintf(fp, "\n");
-    fclose(fp);
-    inOrderTraverse(binaryTree->root, saveHelper);
+    FILE *fp = fopen(FILE_TEMP, "wb");
+    if (fp == NULL) {
+        return ERROR;
+    }
+    Status status = saveHelper(binaryTree, fp, format);
+    if (fclose(fp) != 0 && status == OK) {
+        status = ERROR;
+    }
+#ifdef WIN32
+    if (status == OK) { // rename doesn't replace an existing file
+        remove(FILE_NAME);
+    }
+#endif
+    if (status != OK || rename(FILE_TEMP, FILE_NAME) != 0) {
+        remove(FILE_TEMP);
+        return status == OVERFLOW ? OVERFLOW : ERROR;
+    }
     return OK;
 }
 
+/**
+ * Report memory used by nodes, parent links and the key index
+ * @param {BinaryTree *} binaryTree - binaryTree
+ * @return {Status} - execution status
+ */
+Status memoryReport(BinaryTree *binaryTree) {
+    if (!binaryTree->initialized) { // binaryTree doesn't exist
+        return ERROR;
+    }
+    size_t nodes = (size_t) binaryTree->index.size, capacity = 0;
+    int blocks = 0;
+    for (TreeBlock *block = binaryTree->blocks; block; block = block->next) {
+        capacity += (size_t) block->capacity;
+        blocks++;
+    }
+    size_t index = binaryTree->index.entries ? sizeof(IndexEntry) << binaryTree->index.bits : 0;
+    printf("nodes: %zu x %zu bytes = %zu bytes\n", nodes, sizeof(TreeNode), nodes * sizeof(TreeNode));
+    printf("node blocks: %d, room for %zu nodes = %zu bytes, %d released nodes\n", blocks, capacity,
+           capacity * sizeof(TreeNode), binaryTree->freeCount);
+#ifdef TREE_PARENT_LINKS
+    printf("parent links: on, %zu bytes of them\n", nodes * sizeof(TreeNode *));
+#else
+    printf("parent links: off, parents are kept in the index\n");
+#endif
+    printf("index: %d slots x %zu bytes = %zu bytes\n", binaryTree->index.entries ? 1 << binaryTree->index.bits : 0,
+           sizeof(IndexEntry), index);
+    size_t stack = sizeof(TreeNode *) * (size_t) binaryTree->stackSize;
+    printf("traversal stack: %d slots = %zu bytes\n", binaryTree->stackSize, stack);
+    printf("total: %zu bytes\n", capacity * sizeof(TreeNode) + index + stack);
+    return OK;
+}
+
+/**
+ * Helper function of benchmarks to define a tree with keys 0 to length - 1
+ * @param {ElemType *} preOrder - output, pre order definition
+ * @param {ElemType *} inOrder - output, in order definition
+ * @param {int} length - number of nodes
+ * @param {int} shape - 0 for left-skewed, 1 for right-skewed, 2 for balanced
+ * @return {void}
+ */
+void shapeHelper(ElemType *preOrder, ElemType *inOrder, int length, int shape) {
+    for (int i = 0; i < length; i++) { // keys are in order for all shapes
+        inOrder[i].key = i;
+        inOrder[i].value = i;
+    }
+    if (shape == 0) { // every node is the left child of the previous one
+        for (int i = 0; i < length; i++) {
+            preOrder[i] = inOrder[length - 1 - i];
+        }
+    } else if (shape == 1) { // every node is the right child of the previous one
+        for (int i = 0; i < length; i++) {
+            preOrder[i] = inOrder[i];
+        }
+    } else { // middle of each range is its root
+        int ranges[128], top = 0, count = 0;
+        ranges[top++] = 0;
+        ranges[top++] = length - 1;
+        while (top) {
+            int high = ranges[--top];
+            int low = ranges[--top];
+            if (low > high) {
+                continue;
+            }
+            int middle = low + (high - low) / 2;
+            preOrder[count++] = inOrder[middle];
+            ranges[top++] = middle + 1;
+            ranges[top++] = high;
+            ranges[top++] = low;
+            ranges[top++] = middle - 1;
+        }
+    }
+}
+
+/**
+ * Benchmark of creating trees of three shapes with keys 0 to length - 1
+ * @param {int} length - number of nodes
+ * @return {Status} - execution status
+ */
+Status createBenchmark(int length) {
+    if (length < 1) {
+        return ERROR;
+    }
+    ElemType *preOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    ElemType *inOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    if (!preOrder || !inOrder) {
+        free(preOrder);
+        free(inOrder);
+        return OVERFLOW;
+    }
+    const char *shapes[] = {"left-skewed", "right-skewed", "balanced"};
+    Status status = OK;
+    for (int shape = 0; shape < 3 && status == OK; shape++) {
+        shapeHelper(preOrder, inOrder, length, shape);
+        BinaryTree binaryTree;
+        binaryTree.initialized = FALSE;
+        initializeBinaryTree(&binaryTree);
+        clock_t start = clock();
+        status = createBinaryTree(&binaryTree, preOrder, inOrder, length);
+        double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+        printf("%-12s %d nodes created in %.3f s\n", shapes[shape], length, elapsed);
+        destroyBinaryTree(&binaryTree);
+    }
+    free(preOrder);
+    free(inOrder);
+    return status;
+}
+
+// nodes visited by countHelper
+static long long visitedNodes = 0;
+
+/**
+ * Visitor of benchmarks counting nodes
+ * @param {TreeNode *} e
+ * @return {void}
+ */
+void countHelper(TreeNode *e) {
+    (void) e; // only the visit counts
+    visitedNodes++;
+}
+
+/**
+ * Benchmark of traversal methods on skewed and balanced trees with keys 0 to length - 1
+ * @param {int} length - number of nodes
+ * @return {Status} - execution status
+ */
+Status traverseBenchmark(int length) {
+    if (length < 1) {
+        return ERROR;
+    }
+    ElemType *preOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    ElemType *inOrder = (ElemType *) malloc(sizeof(ElemType) * length);
+    if (!preOrder || !inOrder) {
+        free(preOrder);
+        free(inOrder);
+        return OVERFLOW;
+    }
+    const char *shapes[] = {"left-skewed", "right-skewed", "balanced"};
+    const char *orders[] = {"pre", "in", "post"};
+    const char *methods[] = {"stack", "morris", "recursive"};
+    TraversalOrder flags[] = {STACK_TRAVERSAL, MORRIS_TRAVERSAL, RECURSIVE_TRAVERSAL};
+    Status status = OK;
+    for (int shape = 0; shape < 3 && status == OK; shape++) {
+        shapeHelper(preOrder, inOrder, length, shape);
+        BinaryTree binaryTree;
+        binaryTree.initialized = FALSE;
+        initializeBinaryTree(&binaryTree);
+        status = createBinaryTree(&binaryTree, preOrder, inOrder, length);
+        for (int method = 0; method < 3 && status == OK; method++) {
+            if (method == 2 && shape != 2) { // skewed trees overflow the call stack
+                continue;
+            }
+            for (TraversalOrder order = PRE_ORDER; order <= POST_ORDER && status == OK; order++) {
+                visitedNodes = 0;
+                clock_t start = clock();
+                status = binaryTreeTraverse(&binaryTree, order | flags[method], countHelper);
+                double elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+                printf("%-12s %-9s %-4s order: %lld nodes in %.3f s\n", shapes[shape], methods[method],
+                       orders[order], visitedNodes, elapsed);
+            }
+        }
+        visitedNodes = 0;
+        clock_t start = clock();
+        if (status == OK) {
+            status = binaryTreeTraverse(&binaryTree, LEVEL_ORDER, countHelper);
+        }
+        printf("%-12s level order: %lld nodes in %.3f s\n", shapes[shape], visitedNodes,
+               (double) (clock() - start) / CLOCKS_PER_SEC);
+        start = clock();
+        int depth = binaryTreeDepth(&binaryTree);
+        printf("%-12s depth %d in %.3f s\n", shapes[shape], depth, (double) (clock() - start) / CLOCKS_PER_SEC);
+        destroyBinaryTree(&binaryTree);
+    }
+    free(preOrder);
+    free(inOrder);
+    return status;
+}
+
+/**
+ * Benchmark of an ordered binaryTree filled with ascending keys 0 to length - 1
+ * @param {int} length - number of nodes
+ * @return {Status} - execution status
+ */
+Status orderedBenchmark(int length) {
+    if (length < 1) {
+        return ERROR;
+    }
+    BinaryTree binaryTree;
+    binaryTree.initialized = FALSE;
+    initializeBinaryTree(&binaryTree);
+    orderBinaryTree(&binaryTree);
+    Status status = OK;
+    clock_t start = clock();
+    for (int i = 0; i < length && status == OK; i++) { // worst case of an unbalanced search tree
+        ElemType e = {i, i};
+        status = orderedInsert(&binaryTree, e);
+    }
+    printf("%d ascending keys inserted in %.3f s, depth %d\n", length, (double) (clock() - start) / CLOCKS_PER_SEC,
+           binaryTreeDepth(&binaryTree));
+    start = clock();
+    long long found = 0;
+    for (int i = 0; i < length && status == OK; i++) {
+        found += lowerBound(&binaryTree, i) != NULL;
+    }
+    printf("%lld lower bounds found in %.3f s\n", found, (double) (clock() - start) / CLOCKS_PER_SEC);
+    start = clock();
+    for (int i = 0; i < length && status == OK; i += 2) {
+        status = orderedDelete(&binaryTree, i);
+    }
+    printf("%d keys deleted in %.3f s, depth %d\n", (length + 1) / 2, (double) (clock() - start) / CLOCKS_PER_SEC,
+           binaryTreeDepth(&binaryTree));
+    destroyBinaryTree(&binaryTree);
+    return status;
+}
+
 /**
  * show the value of element
  * @param {TreeNode *} e
@@ -623,6 +2127,21 @@ void showElement(TreeNode *e) {
     printf("%d ", e->data.value);
 }
 
+/**
+ * show the values of a level
+ * @param {TreeNode **} level - nodes of the level
+ * @param {int} count - number of nodes
+ * @param {int} depth - depth of the level, 0 for root
+ * @return {void}
+ */
+void showLevel(TreeNode **level, int count, int depth) {
+    printf("%d:", depth);
+    for (int i = 0; i < count; i++) {
+        printf(" %d", level[i]->data.value);
+    }
+    printf("\n");
+}
+
 /**
  * Helper function to print tree
  * @param {TreeNode *} node - node
@@ -763,6 +2282,12 @@ void showMenu() {
     printf("    19: postOrderTraverse            20: levelOrderTraverse\n");
     printf("    21: selectBinaryTree             22: saveData\n");
     printf("    23: loadData                     24: printTree\n");
+    printf("    25: memoryReport                 26: getAncestors\n");
+    printf("    27: createBenchmark              28: traverseBenchmark\n");
+    printf("    29: levelTraverse                30: compactBinaryTree\n");
+    printf("    31: orderBinaryTree              32: orderedInsert\n");
+    printf("    33: orderedDelete                34: lowerBound/upperBound\n");
+    printf("    35: orderedBenchmark             36: bplusBenchmark\n");
     printf("    0: quit\n");
     printf("------------------------------------------------------\n");
 }
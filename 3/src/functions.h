@@ -1,12 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <malloc.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
 #ifdef WIN32
 #include <winbase.h>
 #include <wincon.h>
 #else
 #include <sys/ioctl.h>
-#include <string.h>
 #endif
 
 /* type definitions */
@@ -21,16 +23,36 @@ typedef int Boolean;
 #define TRUE 1
 #define FALSE 0
 
-// traversal order type
+// traversal order type, may be OR'ed with a traversal method
 typedef int TraversalOrder;
 #define PRE_ORDER 0
 #define IN_ORDER 1
 #define POST_ORDER 2
 #define LEVEL_ORDER 3
+#define ORDER_MASK 3
+
+// traversal methods, ignored by LEVEL_ORDER
+#define STACK_TRAVERSAL 0 // explicit stack kept in the binaryTree, the default
+#define MORRIS_TRAVERSAL 4 // threads the tree while traversing, O(1) extra memory
+#define RECURSIVE_TRAVERSAL 8 // call stack, overflows on deep trees
 
 // number of binaryTrees
 #define TOTAL_TREES 100
 
+// data file format type
+typedef int FileFormat;
+#define TEXT_FORMAT 0 // pre order and in order lines of `key value`
+#define BINARY_FORMAT 1 // pre order and in order elements
+#define COMPACT_FORMAT 2 // pre order elements and child presence bits
+
+// data file
+#define FILE_NAME "data.txt"
+#define FILE_TEMP "data.txt.tmp" // written first, then renamed to FILE_NAME
+#define FILE_BLOCK 65536 // bytes read from or written to data file at a time
+#define FILE_MAGIC "BTRE" // first bytes of a binary data file
+#define CHILD_LEFT 1 // child presence bits, two per node in COMPACT_FORMAT
+#define CHILD_RIGHT 2
+
 typedef int Value;
 
 typedef struct ElemType {
@@ -38,46 +60,192 @@ typedef struct ElemType {
     Value value;
 } ElemType;
 
+// header of a binary data file, `version` is BINARY_FORMAT or COMPACT_FORMAT
+typedef struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t length;
+} FileHeader;
+
+// buffered writer of a data file
+typedef struct FileBuffer {
+    FILE *fp;
+    char *data;
+    size_t size;
+    Status status;
+} FileBuffer;
+
 typedef struct TreeNode {
     ElemType data;
+    int height; // of the subtree in ordered mode, 1 for a leaf
     struct TreeNode *leftChild;
     struct TreeNode *rightChild;
+#ifdef TREE_PARENT_LINKS
+    struct TreeNode *parent; // NULL for root
+#endif
 } TreeNode;
 
+// entry of key index, empty if `node` is NULL
+typedef struct IndexEntry {
+    int key;
+    TreeNode *node;
+#ifndef TREE_PARENT_LINKS
+    TreeNode *parent; // kept here when nodes don't link to their parents
+#endif
+} IndexEntry;
+
+// open-addressing hash index from key to node, with linear probing
+typedef struct TreeIndex {
+    IndexEntry *entries;
+    int bits; // log2 of capacity
+    int size;
+} TreeIndex;
+
+// log2 of initial capacity of index
+#define INDEX_MIN_BITS 4
+
+// nodes allocated at once, released with the tree
+typedef struct TreeBlock {
+    struct TreeBlock *next;
+    int capacity;
+    int used; // nodes handed out so far, the rest are left for allocateNode
+    TreeNode nodes[];
+} TreeBlock;
+
+#define TREE_MIN_BLOCK 64 // capacity of blocks allocateNode creates, doubling up to TREE_MAX_BLOCK
+#define TREE_MAX_BLOCK 65536
+
 typedef struct BinaryTree {
     TreeNode *root;
+    TreeBlock *blocks; // all nodes of the tree live in these, the first one serves allocateNode
+    TreeNode *freeNodes; // released nodes linked by `leftChild`, reused first
+    int freeCount;
+    TreeIndex index;
+    TreeNode **stack; // reused by traversals
+    int stackSize;
+    Boolean ordered; // keys ascend in order and the tree is AVL-balanced
     Boolean initialized;
 } BinaryTree;
 
-TreeNode *createHelper(ElemType *preOrder, ElemType *inOrder, int index, int start, int end);
+// B+tree of key/value pairs, see bplustree.c
+#define BPLUS_KEYS 32 // most keys in a node, a multiple of 4 for SIMD search
+#define BPLUS_MIN_KEYS (BPLUS_KEYS / 2) // fewest keys in a node other than root
+#define BPLUS_MAX_HEIGHT 16
+
+// head of both node types, unused keys are INT32_MAX
+typedef struct BPlusNode {
+    int count;
+    Boolean isLeaf;
+    int keys[BPLUS_KEYS];
+} BPlusNode;
+
+// keys of children[i] are at least keys[i - 1] and less than keys[i]
+typedef struct BPlusInner {
+    BPlusNode node;
+    BPlusNode *children[BPLUS_KEYS + 1];
+} BPlusInner;
+
+typedef struct BPlusLeaf {
+    BPlusNode node;
+    Value values[BPLUS_KEYS];
+    struct BPlusLeaf *next; // leaves are linked in key order
+} BPlusLeaf;
+
+typedef struct BPlusTree {
+    BPlusNode *root;
+    BPlusLeaf *first;
+    int size;
+    int height; // 1 when root is a leaf
+    Boolean initialized;
+} BPlusTree;
+
+TreeNode *allocateNode(BinaryTree *binaryTree);
+TreeNode *balanceHelper(BinaryTree *binaryTree, TreeNode *node);
 TreeNode *getLeftChild(BinaryTree *binaryTree, int key);
 TreeNode *getLeftSibling(BinaryTree *binaryTree, int key);
 TreeNode *getNode(BinaryTree *binaryTree, int key);
-TreeNode *getParentHelper(TreeNode *node, int key);
 TreeNode *getParent(BinaryTree *binaryTree, int key);
 TreeNode *getRightChild(BinaryTree *binaryTree, int key);
 TreeNode *getRightSibling(BinaryTree *binaryTree, int key);
 TreeNode *getRoot(BinaryTree *binaryTree);
+TreeNode *lowerBound(BinaryTree *binaryTree, int key);
+TreeNode *orderHelper(BinaryTree *binaryTree, TreeNode **nodes, int length, TreeNode *parent);
+TreeNode *parentOf(BinaryTree *binaryTree, TreeNode *node);
+TreeNode *rotateHelper(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft);
+TreeNode *upperBound(BinaryTree *binaryTree, int key);
+TreeBlock *blockCreate(int capacity);
+BPlusLeaf *bplusFindLeaf(BPlusTree *bplusTree, int key);
+IndexEntry *indexFind(TreeIndex *index, int key);
 ElemType *scanHelper(int length, FILE *fp);
 int binaryTreeDepth(BinaryTree *binaryTree);
 Status binaryTreeTraverse(BinaryTree *binaryTree, TraversalOrder traversalOrder, void (*visitor)(TreeNode *));
+Status bplusBenchmark(int length);
+Status bplusBulkLoad(BPlusTree *bplusTree, ElemType *elements, int length);
+int bplusChild(BPlusNode *node, int key);
+Status bplusDelete(BPlusTree *bplusTree, int key);
+Status bplusDestroy(BPlusTree *bplusTree);
+Status bplusFind(BPlusTree *bplusTree, int key, Value *value);
+void bplusFree(BPlusNode *node);
+Status bplusInitialize(BPlusTree *bplusTree);
+Status bplusInsert(BPlusTree *bplusTree, int key, Value value);
+void bplusMerge(BPlusInner *parent, int slot);
+void bplusPad(BPlusNode *node);
+int bplusRange(BPlusTree *bplusTree, int low, int high, void (*visitor)(ElemType e));
+int bplusRank(BPlusNode *node, int key);
+void bplusRebalance(BPlusInner *parent, int slot);
 Status clearBinaryTree(BinaryTree *binaryTree);
+Status compactBinaryTree(BinaryTree *binaryTree);
+void countHelper(TreeNode *e);
+Status createBenchmark(int length);
 Status createBinaryTree(BinaryTree *binaryTree, ElemType *preOrderDefinition, ElemType *inOrderDefinition, int length);
+Status createHelper(BinaryTree *binaryTree, ElemType *preOrder, ElemType *inOrder, int length);
+Status createShapeHelper(BinaryTree *binaryTree, ElemType *preOrder, uint8_t *children, int length);
 Status deleteSubtree(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft);
 Status destroyBinaryTree(BinaryTree *binaryTree);
-void freeHelper(TreeNode *node);
-int getDepthHelper(TreeNode *node, int depth);
+void flushHelper(FileBuffer *file);
+void formatHelper(FileBuffer *file, ElemType e);
+void freeBlocks(TreeBlock *block);
+int getAncestors(BinaryTree *binaryTree, int key, TreeNode **ancestors);
+int getDepthHelper(BinaryTree *binaryTree);
 int getValue(BinaryTree *binaryTree, int key);
-int indexOf(ElemType item, ElemType *array, int length);
+int heightOf(TreeNode *node);
+void indexClear(TreeIndex *index);
+uint32_t indexHash(int key, int bits);
+Status indexInsert(TreeIndex *index, int key, TreeNode *node, TreeNode *parent);
+void indexRemove(TreeIndex *index, IndexEntry *entry);
+Status indexResize(TreeIndex *index, int bits);
+Status indexSubtree(TreeIndex *index, TreeNode *node, TreeNode *parent, Boolean isAdd);
 Status initializeBinaryTree(BinaryTree *binaryTree);
 Status insertSubtree(BinaryTree *binaryTree, TreeNode *node, Boolean isLeft, BinaryTree *newTree);
 Boolean isBinaryTreeEmpty(BinaryTree *binaryTree);
+int keyCompareHelper(const void *a, const void *b);
+Status levelTraverse(BinaryTree *binaryTree, void (*visitor)(TreeNode **level, int count, int depth));
+Status loadBinaryHelper(BinaryTree *binaryTree, FILE *fp);
 Status loadData(BinaryTree *binaryTree);
+Status memoryReport(BinaryTree *binaryTree);
+void morrisTraverse(TreeNode *root, TraversalOrder traversalOrder, void (*visitor)(TreeNode *));
+int nodeDepth(BinaryTree *binaryTree, int key);
+Status orderBinaryTree(BinaryTree *binaryTree);
+Status orderedBenchmark(int length);
+Status orderedDelete(BinaryTree *binaryTree, int key);
+Status orderedInsert(BinaryTree *binaryTree, ElemType e);
+Status parseHelper(FILE *fp, ElemType **elements, int *count);
 int printHelper(TreeNode *node, Boolean isLeft, int offset, int depth, char** buffer);
 Status print(BinaryTree *binaryTree);
-Status saveData(BinaryTree *binaryTree);
-void saveHelper(TreeNode *node);
+void rebalanceHelper(BinaryTree *binaryTree, TreeNode **path, int length);
+void releaseNode(BinaryTree *binaryTree, TreeNode *node);
+void reverseHelper(TreeNode *from, TreeNode *to);
+Status saveData(BinaryTree *binaryTree, FileFormat format);
+Status saveHelper(BinaryTree *binaryTree, FILE *fp, FileFormat format);
 Status selectBinaryTree(BinaryTree **currentBinaryTree, BinaryTree *nextBinaryTree);
+void setParent(BinaryTree *binaryTree, TreeNode *node, TreeNode *parent);
 Status setValue(BinaryTree *binaryTree, int key, Value value);
+void shapeHelper(ElemType *preOrder, ElemType *inOrder, int length, int shape);
 void showElement(TreeNode *e);
+void showLevel(TreeNode **level, int count, int depth);
+Status stackReserve(BinaryTree *binaryTree);
+void stackTraverse(BinaryTree *binaryTree, TraversalOrder traversalOrder, void (*visitor)(TreeNode *));
+Status traverseBenchmark(int length);
+void updateHeight(TreeNode *node);
+void writeHelper(FileBuffer *file, const void *data, size_t size);
 void showMenu();
\ No newline at end of file